@@ -4,8 +4,111 @@
 
 #include <set>
 #include <list>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <utility>
+#include <type_traits>
 #include "graph.h"
+#include "csrgraph.h"
+#include "distmatrix.h"
+#include "isochrone.h"
 #include "pqueue.h"
+#include "searchstats.h"
+#include "threadpool.h"
+
+//  A*             .
+//         .
+//    AStarSearch  ,       .
+//  ,    ,     AStarHeuristic<, _>
+//     get_cost(const TGraph& graph, int start, int goal) const, 
+//           (Graph, CSRGraph).
+//               ;
+//        (,  ),    
+//  get_min_cost(const TGraph& graph, int start, const std::set<int>& goal_group) const.
+//    A*        
+//  get_min_reverse_cost,   -  get_cost(graph, s, vertex)   s ;
+//    (, ALT      )   ,
+//  get_min_cost(graph, vertex, group).         .
+//   A*      .
+//      (AStarSearch::AStarDefaultHeuristic)   
+// (    ).
+template<typename THeuristic, typename TEdgeWeight>
+struct AStarHeuristic
+{
+	static const bool is_zero_heuristic = false;
+
+	template<typename TGraph>
+	TEdgeWeight get_min_cost(const TGraph& graph, int start, const std::set<int>& goal_group) const;
+	template<typename TGraph>
+	TEdgeWeight get_min_reverse_cost(const TGraph& graph, int vertex, const std::set<int>& start_group) const;
+};
+
+//          ,   .
+// ,  goal_group  .
+template<typename THeuristic, typename TEdgeWeight>
+template<typename TGraph>
+TEdgeWeight AStarHeuristic<THeuristic, TEdgeWeight>::get_min_cost(
+	const TGraph& graph, int start, const std::set<int>& goal_group) const
+{
+	const THeuristic& heuristic = static_cast<const THeuristic&>(*this);
+	TEdgeWeight current_weight;
+	TEdgeWeight min_weight = heuristic.get_cost(graph, start, *goal_group.begin());
+	for(std::set<int>::const_iterator i=++goal_group.begin(); i != goal_group.end(); ++i)
+	{
+		current_weight = heuristic.get_cost(graph, start, *i);
+		min_weight = current_weight < min_weight ? current_weight : min_weight;
+	}
+	return min_weight;
+}
+
+//          ,   .
+// ,  start_group  .
+template<typename THeuristic, typename TEdgeWeight>
+template<typename TGraph>
+TEdgeWeight AStarHeuristic<THeuristic, TEdgeWeight>::get_min_reverse_cost(
+	const TGraph& graph, int vertex, const std::set<int>& start_group) const
+{
+	const THeuristic& heuristic = static_cast<const THeuristic&>(*this);
+	TEdgeWeight current_weight;
+	TEdgeWeight min_weight = heuristic.get_cost(graph, *start_group.begin(), vertex);
+	for(std::set<int>::const_iterator i=++start_group.begin(); i != start_group.end(); ++i)
+	{
+		current_weight = heuristic.get_cost(graph, *i, vertex);
+		min_weight = current_weight < min_weight ? current_weight : min_weight;
+	}
+	return min_weight;
+}
+
+// ,      ( is_zero_heuristic = true).
+template<typename THeuristic, typename = void>
+struct IsZeroHeuristic : std::false_type { };
+
+template<typename THeuristic>
+struct IsZeroHeuristic<THeuristic, typename std::enable_if<THeuristic::is_zero_heuristic>::type> : std::true_type { };
+
+// ,            ( get_goal_group(),
+//  AStarEuclidianGoalSetHeuristic);       .
+template<typename THeuristic, typename = void>
+struct HasHeuristicGroup : std::false_type { };
+
+template<typename THeuristic>
+struct HasHeuristicGroup<THeuristic, decltype(static_cast<void>(std::declval<const THeuristic&>().get_goal_group()))>
+	: std::true_type { };
+
+// ,     get_min_cost:        ,
+//    ,  group.      ,     ,
+//       ,     .
+template<typename THeuristic>
+inline const std::set<int>& get_heuristic_group(const THeuristic& heuristic, const std::set<int>& group)
+{
+	if constexpr(HasHeuristicGroup<THeuristic>::value)
+	{
+		if(group == heuristic.get_goal_group())
+			return heuristic.get_goal_group();
+	}
+	return group;
+}
 
 //     A*
 template<typename TVertexValue, typename TEdgeWeight>
@@ -13,14 +116,99 @@ class AStarSearch
 {	
 public:
 	struct AStarDefaultHeuristic;
+	class SearchContext;
+	class BidirectionalSearchContext;
+	struct SearchResult;
+	struct SearchOptions;
+	typedef std::pair<std::set<int>, std::set<int>> SearchQuery;
+	enum SearchStatus { PATH_FOUND, PATH_NOT_FOUND, SEARCH_TIMED_OUT };
+	template<typename TGraph, typename THeuristic>
 	static bool find_shortest_path(
-		const Graph<TVertexValue, TEdgeWeight>& graph, const std::set<int> start_group, const std::set<int> goal_group,
-		const AStarDefaultHeuristic& heuristic, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	template<typename TGraph, typename THeuristic>
+	static bool find_shortest_path(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, SearchContext& context,
+		std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+	static bool find_shortest_path(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, SearchContext& context, TStatisticsPolicy& statistics,
+		std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	template<typename TGraph, typename THeuristic>
+	static SearchStatus find_path(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, const SearchOptions& options, SearchContext& context,
+		std::list<int>& path, TEdgeWeight& path_cost);
+	template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+	static SearchStatus find_path(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, const SearchOptions& options, SearchContext& context,
+		TStatisticsPolicy& statistics, std::list<int>& path, TEdgeWeight& path_cost);
+	template<typename TGraph, typename THeuristic>
+	static bool find_shortest_path_bidirectional(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	template<typename TGraph, typename THeuristic>
+	static bool find_shortest_path_bidirectional(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, BidirectionalSearchContext& context,
+		std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+	static bool find_shortest_path_bidirectional(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, BidirectionalSearchContext& context, TStatisticsPolicy& statistics,
+		std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	template<typename TGraph, typename THeuristic>
+	static void find_shortest_paths(
+		const TGraph& graph, const std::vector<SearchQuery>& queries,
+		const THeuristic& heuristic, std::vector<SearchResult>& results);
+	template<typename TGraph, typename THeuristic>
+	static void find_shortest_paths(
+		const TGraph& graph, const std::vector<SearchQuery>& queries,
+		const THeuristic& heuristic, ThreadPool& pool, std::vector<SearchResult>& results);
+	template<typename TGraph>
+	static bool find_distance_matrix(
+		const TGraph& graph, const std::vector<int>& sources, const std::vector<int>& targets,
+		DistanceMatrix<TEdgeWeight>& matrix);
+	template<typename TGraph>
+	static bool find_distance_matrix(
+		const TGraph& graph, const std::vector<int>& sources, const std::vector<int>& targets,
+		ThreadPool& pool, DistanceMatrix<TEdgeWeight>& matrix);
+	template<typename TGraph>
+	static bool find_reachable(
+		const TGraph& graph, const std::set<int>& start_group, const std::vector<TEdgeWeight>& budgets,
+		Isochrone<TEdgeWeight>& isochrone);
+	template<typename TGraph>
+	static bool find_reachable(
+		const TGraph& graph, const std::set<int>& start_group, const std::vector<TEdgeWeight>& budgets,
+		SearchContext& context, Isochrone<TEdgeWeight>& isochrone);
 private :
 	enum StatusCode { UNDISCOVERED, OPEN, CLOSED, UNDISCOVERED_GOAL, OPEN_GOAL };
 	struct VertexStatus;
-	static TEdgeWeight min_heuristic_cost(const Graph<TVertexValue, TEdgeWeight>& graph,
-		const int start, const std::set<int> goal_group, const AStarDefaultHeuristic& heuristic);
+	template<typename TQueue>
+	class BestFirstOpenList;
+	class FocalOpenList;
+	template<typename TGraph, typename THeuristic, typename TStatisticsPolicy, typename TOpenList>
+	static SearchStatus search(
+		const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, const SearchOptions& options, SearchContext& context, TOpenList& open_list,
+		TStatisticsPolicy& statistics, std::list<int>& path, TEdgeWeight& path_cost);
+	static TEdgeWeight inflate_cost(const TEdgeWeight& cost, const double factor);
+	static void get_path(SearchContext& context, int vertex, std::list<int>& path);
+	template<typename TGraph>
+	static TEdgeWeight get_path_cost(const TGraph& graph, const std::list<int>& path);
+	template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+	static TEdgeWeight min_heuristic_cost(const TGraph& graph, const int start, const std::set<int>& goal_group,
+		const THeuristic& heuristic, TStatisticsPolicy& statistics);
+	template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+	static TEdgeWeight get_bidirectional_potential(const TGraph& graph, const int vertex, const std::set<int>& start_group,
+		const std::set<int>& goal_group, const int direction, const THeuristic& heuristic, TStatisticsPolicy& statistics);
+	template<typename TGraph>
+	static void find_distance_row(const TGraph& graph, const int source, const std::vector<int>& targets,
+		const std::vector<int>& target_vertices, SearchContext& context,
+		DistanceMatrix<TEdgeWeight>& matrix, const int source_index);
 };
 
 template<typename TVertexValue, typename TEdgeWeight>
@@ -33,24 +221,190 @@ struct AStarSearch<TVertexValue, TEdgeWeight>::VertexStatus
 	TEdgeWeight heuristic_cost_from_this_to_goal;
 	TEdgeWeight heuristic_cost_from_start_to_goal;
 
-	VertexStatus() : vertex(-1), status_code(UNDISCOVERED), parent(-1), cost_from_start_to_this(TEdgeWeight()),
+	VertexStatus() : vertex(-1), parent(-1), status_code(UNDISCOVERED), cost_from_start_to_this(TEdgeWeight()),
 		heuristic_cost_from_this_to_goal(TEdgeWeight()), heuristic_cost_from_start_to_goal(TEdgeWeight()) {}
+};
+
+//   ,     .
+//               :
+//      (),       ,
+//           .
+//       ,    .
+//       RadixHeap (. SearchPriorityQueue):  
+//      ,        .
+//        .
+template<typename TVertexValue, typename TEdgeWeight>
+class AStarSearch<TVertexValue, TEdgeWeight>::SearchContext
+{
+	friend class AStarSearch<TVertexValue, TEdgeWeight>;
+
+	std::vector<VertexStatus> vertices_status;
+	std::vector<unsigned int> generations;
+	unsigned int generation;
+	typename SearchPriorityQueue<TEdgeWeight>::type open_vertices_queue;
+	//   WEIGHTED  FOCAL (. SearchOptions);        .
+	IndexedPriorityQueue<TEdgeWeight> ordered_queue;
+	IndexedPriorityQueue<std::pair<TEdgeWeight, TEdgeWeight>> pending_queue;
+	IndexedPriorityQueue<std::pair<TEdgeWeight, TEdgeWeight>> focal_queue;
+	size_t num_settled;
 
-	bool operator<(const VertexStatus& rhs) const { return heuristic_cost_from_start_to_goal < rhs.heuristic_cost_from_start_to_goal; }
-	bool operator==(const VertexStatus& rhs) const { return vertex == rhs.vertex; }
+	void reset(int num_vertices);
+	VertexStatus& get_status(int vertex);
+public:
+	SearchContext() : generation(0), num_settled(0) { }
+	explicit SearchContext(int num_vertices);
+	//  ,      .
+	size_t get_num_settled() const { return num_settled; }
 };
 
-//  A*             . 
-//         .
-//    AStarDefaultHeuristic     .
-//  ,    ,     AStarDefaultHeuristic     get_cost().
-//   A*      .
-//      ,       (    ).
+//    :   SearchContext     .
+template<typename TVertexValue, typename TEdgeWeight>
+class AStarSearch<TVertexValue, TEdgeWeight>::BidirectionalSearchContext
+{
+	friend class AStarSearch<TVertexValue, TEdgeWeight>;
+
+	SearchContext forward;
+	SearchContext backward;
+public:
+	BidirectionalSearchContext() { }
+	explicit BidirectionalSearchContext(int num_vertices) : forward(num_vertices), backward(num_vertices) { }
+	size_t get_num_settled() const { return forward.get_num_settled() + backward.get_num_settled(); }
+};
+
+//     .
+template<typename TVertexValue, typename TEdgeWeight>
+struct AStarSearch<TVertexValue, TEdgeWeight>::SearchResult
+{
+	bool is_found;
+	std::list<int> shortest_path;
+	TEdgeWeight shortest_path_cost;
+
+	SearchResult() : is_found(false), shortest_path_cost(TEdgeWeight()) {}
+};
+
+//     find_path.
+// OPTIMAL -  A*,  .
+// WEIGHTED -  A*:    g + (1 + suboptimality)*h.   
+//     (1 + suboptimality)  ,      .
+//   A*  ,   RadixHeap   IndexedPriorityQueue.
+// FOCAL -   A*eps:     g + h   (1 + suboptimality)  
+//      h,     .   ,   WEIGHTED;
+//   ,    ,       .
+//      .  suboptimality  .
+// -   FOCAL        ,  OPTIMAL;
+// ,     ,   WEIGHTED.
+// max_settled   ,   , max_seconds -  ; 0 -  .
+//     64  ,         .
+template<typename TVertexValue, typename TEdgeWeight>
+struct AStarSearch<TVertexValue, TEdgeWeight>::SearchOptions
+{
+	enum Mode { OPTIMAL, WEIGHTED, FOCAL };
+
+	Mode mode;
+	double suboptimality;
+	size_t max_settled;
+	double max_seconds;
+
+	SearchOptions() : mode(OPTIMAL), suboptimality(0.0), max_settled(0), max_seconds(0.0) {}
+};
+
+//    ,    :  queue   g + h
+// (  WEIGHTED  h  ).
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TQueue>
+class AStarSearch<TVertexValue, TEdgeWeight>::BestFirstOpenList
+{
+	TQueue& queue;
+public:
+	static const bool is_reopening = false;
+
+	explicit BestFirstOpenList(TQueue& queue) : queue(queue) { }
+	void reset(int num_vertices) { queue.resize(num_vertices); queue.clear(); }
+	bool empty() const { return queue.empty(); }
+	int pop() { int vertex = queue.top(); queue.pop(); return vertex; }
+	void push(int vertex, const TEdgeWeight& cost, const TEdgeWeight&) { queue.push(vertex, cost); }
+	void decrease_key(int vertex, const TEdgeWeight& cost, const TEdgeWeight&) { queue.decrease_key(vertex, cost); }
+};
+
+//     . ordered_queue      f = g + h,
+// focal_queue -   (f   focal_factor  )   (h, f),
+// pending_queue -      (f, h).     f
+//  ,      pending_queue  ,     .
+//   focal_bound   ,      ordered_queue,
+//     .  ordered_queue       :
+//   f   (,   ,      ),   
+//     f  focal_factor     .
+template<typename TVertexValue, typename TEdgeWeight>
+class AStarSearch<TVertexValue, TEdgeWeight>::FocalOpenList
+{
+	IndexedPriorityQueue<TEdgeWeight>& ordered_queue;
+	IndexedPriorityQueue<std::pair<TEdgeWeight, TEdgeWeight>>& pending_queue;
+	IndexedPriorityQueue<std::pair<TEdgeWeight, TEdgeWeight>>& focal_queue;
+	double focal_factor;
+	TEdgeWeight focal_bound;
+public:
+	static const bool is_reopening = true;
+
+	FocalOpenList(SearchContext& context, double focal_factor) : ordered_queue(context.ordered_queue),
+		pending_queue(context.pending_queue), focal_queue(context.focal_queue), focal_factor(focal_factor),
+		focal_bound(TEdgeWeight()) { }
+	void reset(int num_vertices);
+	bool empty() const { return ordered_queue.empty(); }
+	int pop();
+	void push(int vertex, const TEdgeWeight& cost, const TEdgeWeight& heuristic_cost);
+	void decrease_key(int vertex, const TEdgeWeight& cost, const TEdgeWeight& heuristic_cost);
+};
+
+template<typename TVertexValue, typename TEdgeWeight>
+AStarSearch<TVertexValue, TEdgeWeight>::SearchContext::SearchContext(int num_vertices) : generation(0), num_settled(0)
+{
+	reset(num_vertices);
+}
+
+//   :           .
+template<typename TVertexValue, typename TEdgeWeight>
+void AStarSearch<TVertexValue, TEdgeWeight>::SearchContext::reset(int num_vertices)
+{
+	if(static_cast<size_t>(num_vertices) > vertices_status.size())
+	{
+		vertices_status.resize(num_vertices);
+		generations.resize(num_vertices, 0);
+		open_vertices_queue.resize(num_vertices);
+	}
+	open_vertices_queue.clear();
+	num_settled = 0;
+
+	++generation;
+	if(generation == 0)
+	{
+		std::fill(generations.begin(), generations.end(), 0);
+		generation = 1;
+	}
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+inline typename AStarSearch<TVertexValue, TEdgeWeight>::VertexStatus&
+	AStarSearch<TVertexValue, TEdgeWeight>::SearchContext::get_status(int vertex)
+{
+	if(generations[vertex] != generation)
+	{
+		generations[vertex] = generation;
+		vertices_status[vertex] = VertexStatus();
+	}
+	return vertices_status[vertex];
+}
+
+//    .      is_zero_heuristic (. IsZeroHeuristic)
+//     ,     find_shortest_path    .
 template<typename TVertexValue, typename TEdgeWeight>
 struct AStarSearch<TVertexValue, TEdgeWeight>::AStarDefaultHeuristic
 {
-	virtual ~AStarDefaultHeuristic() { }
-	virtual TEdgeWeight get_cost(const Graph<TVertexValue, TEdgeWeight> graph, int start, int goal) const { return TEdgeWeight(); }
+	static const bool is_zero_heuristic = true;
+
+	template<typename TGraph>
+	TEdgeWeight get_cost(const TGraph&, int, int) const { return TEdgeWeight(); }
+	template<typename TGraph>
+	TEdgeWeight get_min_cost(const TGraph&, int, const std::set<int>&) const { return TEdgeWeight(); }
 };
 
 //  A*         .
@@ -58,119 +412,818 @@ struct AStarSearch<TVertexValue, TEdgeWeight>::AStarDefaultHeuristic
 //      ,      <<>> ,
 //          .
 //        A*      .
+//       Graph,      CSRGraph.
+//         ;    
+//   SearchContext.
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_path(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic,	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	SearchContext context;
+	return find_shortest_path(graph, start_group, goal_group, heuristic, context, shortest_path, shortest_path_cost);
+}
+
+//      context,       .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_path(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, SearchContext& context,
+	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	NoSearchStatistics statistics;
+	return find_shortest_path(graph, start_group, goal_group, heuristic, context, statistics,
+		shortest_path, shortest_path_cost);
+}
+
+//    : statistics - SearchStatistics        
+// (. searchstats.h);  NoSearchStatistics      .
 template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
 bool AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_path(
-	const Graph<TVertexValue, TEdgeWeight>& graph, const std::set<int> start_group, const std::set<int> goal_group,
-	const AStarDefaultHeuristic& heuristic,	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, SearchContext& context, TStatisticsPolicy& statistics,
+	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	BestFirstOpenList<typename SearchPriorityQueue<TEdgeWeight>::type> open_list(context.open_vertices_queue);
+	return search(graph, start_group, goal_group, heuristic, SearchOptions(), context, open_list, statistics,
+		shortest_path, shortest_path_cost) == PATH_FOUND;
+}
+
+//       (. SearchOptions).  PATH_FOUND,  
+//    , PATH_NOT_FOUND,       ,  SEARCH_TIMED_OUT,
+//     max_settled  max_seconds.     path   
+//      (  - path_cost),
+//         , path .      
+//    ,      .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic>
+typename AStarSearch<TVertexValue, TEdgeWeight>::SearchStatus AStarSearch<TVertexValue,TEdgeWeight>::find_path(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, const SearchOptions& options, SearchContext& context,
+	std::list<int>& path, TEdgeWeight& path_cost)
+{
+	NoSearchStatistics statistics;
+	return find_path(graph, start_group, goal_group, heuristic, options, context, statistics, path, path_cost);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+typename AStarSearch<TVertexValue, TEdgeWeight>::SearchStatus AStarSearch<TVertexValue,TEdgeWeight>::find_path(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, const SearchOptions& options, SearchContext& context,
+	TStatisticsPolicy& statistics, std::list<int>& path, TEdgeWeight& path_cost)
+{
+	const double factor = 1.0 + std::max(options.suboptimality, 0.0);
+	if(options.mode == SearchOptions::WEIGHTED)
+	{
+		BestFirstOpenList<IndexedPriorityQueue<TEdgeWeight>> open_list(context.ordered_queue);
+		return search(graph, start_group, goal_group, heuristic, options, context, open_list, statistics,
+			path, path_cost);
+	}
+	if(options.mode == SearchOptions::FOCAL)
+	{
+		FocalOpenList open_list(context, factor);
+		return search(graph, start_group, goal_group, heuristic, options, context, open_list, statistics,
+			path, path_cost);
+	}
+	BestFirstOpenList<typename SearchPriorityQueue<TEdgeWeight>::type> open_list(context.open_vertices_queue);
+	return search(graph, start_group, goal_group, heuristic, options, context, open_list, statistics,
+		path, path_cost);
+}
+
+//   A*   :     open_list.
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic, typename TStatisticsPolicy, typename TOpenList>
+typename AStarSearch<TVertexValue, TEdgeWeight>::SearchStatus AStarSearch<TVertexValue,TEdgeWeight>::search(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, const SearchOptions& options, SearchContext& context, TOpenList& open_list,
+	TStatisticsPolicy& statistics, std::list<int>& path, TEdgeWeight& path_cost)
 {
 	if(start_group.empty() || goal_group.empty())
-		return false;
+		return PATH_NOT_FOUND;
+
+	SearchStatisticsScope<TStatisticsPolicy> statistics_scope(statistics);
 
-	std::vector<VertexStatus> vertices_status(graph.get_num_vertices(), VertexStatus());
-	for(std::set<int>::iterator i=goal_group.begin(); i != goal_group.end(); ++i)
+	const int num_vertices = graph.get_num_vertices();
+	const std::set<int>& heuristic_goal_group = get_heuristic_group(heuristic, goal_group);
+	context.reset(num_vertices);
+	open_list.reset(num_vertices);
+	for(std::set<int>::const_iterator i=goal_group.begin(); i != goal_group.end(); ++i)
 	{
 		int vertex = *i;
-		if(vertex > graph.get_num_vertices() || vertex < 0)
-			return false;
-		vertices_status[vertex].vertex = vertex;
-		vertices_status[vertex].status_code = UNDISCOVERED_GOAL;
+		if(vertex >= num_vertices || vertex < 0)
+			return PATH_NOT_FOUND;
+		VertexStatus& vertex_status = context.get_status(vertex);
+		vertex_status.vertex = vertex;
+		vertex_status.status_code = UNDISCOVERED_GOAL;
+	}
+
+	//   WEIGHTED   heuristic_cost_from_this_to_goal   .
+	const double heuristic_factor = options.mode == SearchOptions::WEIGHTED ?
+		1.0 + std::max(options.suboptimality, 0.0) : 1.0;
+	//  ,       next_limit_check,
+	//           .
+	const size_t NO_LIMIT = static_cast<size_t>(-1);
+	const size_t DEADLINE_CHECK_INTERVAL = 64;
+	const bool has_deadline = options.max_seconds > 0.0;
+	const size_t max_settled = options.max_settled != 0 ? options.max_settled : NO_LIMIT;
+	size_t next_limit_check = has_deadline ? std::min(DEADLINE_CHECK_INTERVAL, max_settled) : max_settled;
+	std::chrono::steady_clock::time_point deadline;
+	if(has_deadline)
+	{
+		deadline = std::chrono::steady_clock::now() +
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(options.max_seconds));
 	}
+	//        -    .
+	int best_goal = -1;
 
-	PriorityQueue<VertexStatus> open_vertices_queue;
-	for(std::set<int>::iterator i=start_group.begin(); i != start_group.end(); ++i)
+	//        heuristic_cost_from_start_to_goal.
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
 	{
 		int start = *i;
-		if(start > graph.get_num_vertices() || start < 0)
-			return false;
+		if(start >= num_vertices || start < 0)
+			return PATH_NOT_FOUND;
 
-		vertices_status[start].vertex = start;
-		vertices_status[start].status_code = OPEN;
-		vertices_status[start].cost_from_start_to_this = TEdgeWeight();
-		vertices_status[start].heuristic_cost_from_this_to_goal = min_heuristic_cost(graph, start, goal_group, heuristic);
-		vertices_status[start].heuristic_cost_from_start_to_goal = vertices_status[start].heuristic_cost_from_this_to_goal;
+		VertexStatus& start_status = context.get_status(start);
+		start_status.vertex = start;
+		start_status.status_code = start_status.status_code == UNDISCOVERED_GOAL ? OPEN_GOAL : OPEN;
+		start_status.cost_from_start_to_this = TEdgeWeight();
+		start_status.heuristic_cost_from_this_to_goal = min_heuristic_cost(graph, start, heuristic_goal_group, heuristic, statistics);
+		if(heuristic_factor != 1.0)
+			start_status.heuristic_cost_from_this_to_goal = inflate_cost(start_status.heuristic_cost_from_this_to_goal, heuristic_factor);
+		start_status.heuristic_cost_from_start_to_goal = start_status.heuristic_cost_from_this_to_goal;
+		if(start_status.status_code == OPEN_GOAL)
+			best_goal = start;
 
-		open_vertices_queue.push(vertices_status[start]);
+		open_list.push(start, start_status.heuristic_cost_from_start_to_goal, start_status.heuristic_cost_from_this_to_goal);
+		statistics.on_discover();
+		statistics.on_push();
 	}
 
-	while (!open_vertices_queue.empty())
+	while (!open_list.empty())
 	{
-		VertexStatus open_vertex = open_vertices_queue.top();
-		open_vertices_queue.pop();
-
-		if(vertices_status[open_vertex.vertex].status_code == OPEN_GOAL)
-		{			
-			shortest_path_cost = open_vertex.cost_from_start_to_this;
-			shortest_path.clear();
-			int current_vertex = open_vertex.vertex;
-			while (current_vertex != -1)
+		if(context.num_settled == next_limit_check)
+		{
+			if(context.num_settled == max_settled ||
+				(has_deadline && std::chrono::steady_clock::now() >= deadline))
 			{
-				shortest_path.push_front(current_vertex);
-				current_vertex = vertices_status[current_vertex].parent;
+				path.clear();
+				if(best_goal != -1)
+				{
+					get_path(context, best_goal, path);
+					path_cost = TOpenList::is_reopening ? get_path_cost(graph, path) :
+						context.get_status(best_goal).cost_from_start_to_this;
+				}
+				return SEARCH_TIMED_OUT;
 			}
-			return true;
+			next_limit_check = std::min(next_limit_check + DEADLINE_CHECK_INTERVAL, max_settled);
+		}
+
+		VertexStatus& open_vertex = context.get_status(open_list.pop());
+		++context.num_settled;
+		statistics.on_pop();
+
+		if(open_vertex.status_code == OPEN_GOAL)
+		{			
+			get_path(context, open_vertex.vertex, path);
+			path_cost = TOpenList::is_reopening ? get_path_cost(graph, path) : open_vertex.cost_from_start_to_this;
+			return PATH_FOUND;
 		}
 
-		vertices_status[open_vertex.vertex].status_code = CLOSED;
+		open_vertex.status_code = CLOSED;
+		statistics.on_settle();
 
-		std::vector<Edge<TEdgeWeight>> neighbors;
-		graph.get_neighbors(open_vertex.vertex, neighbors);
+		typename TGraph::NeighborRange neighbors;
+		graph.get_neighbor_range(open_vertex.vertex, neighbors);
 		for(size_t i=0; i < neighbors.size(); ++i)
 		{
-			int neighbor = neighbors[i].destination;
-			if(vertices_status[neighbor].status_code == CLOSED)
+			statistics.on_relax();
+			int neighbor = neighbors.destination(i);
+			VertexStatus& neighbor_status = context.get_status(neighbor);
+			if(neighbor_status.status_code == CLOSED && !TOpenList::is_reopening)
 			{
 				continue;
 			}
 
-			TEdgeWeight edge_weight_to_neighbor;
-			graph.get_edge_weight(open_vertex.vertex, neighbor, edge_weight_to_neighbor);
-			TEdgeWeight cost_from_start_to_neighbor = open_vertex.cost_from_start_to_this + edge_weight_to_neighbor;
+			TEdgeWeight cost_from_start_to_neighbor = open_vertex.cost_from_start_to_this + neighbors.weight(i);
 
-			if((vertices_status[neighbor].status_code == OPEN || vertices_status[neighbor].status_code == OPEN_GOAL) &&
-				cost_from_start_to_neighbor >= vertices_status[neighbor].cost_from_start_to_this)
+			if((neighbor_status.status_code == OPEN || neighbor_status.status_code == OPEN_GOAL ||
+				(TOpenList::is_reopening && neighbor_status.status_code == CLOSED)) &&
+				cost_from_start_to_neighbor >= neighbor_status.cost_from_start_to_this)
 			{
 				continue;
 			}
 
-			if(vertices_status[neighbor].status_code == UNDISCOVERED)
+			//         ,      .
+			//           .
+			bool is_discovered = true;
+			if(neighbor_status.status_code == UNDISCOVERED)
 			{
-				vertices_status[neighbor].vertex = neighbor;
-				vertices_status[neighbor].status_code = OPEN;				
+				neighbor_status.vertex = neighbor;
+				neighbor_status.status_code = OPEN;
+				is_discovered = false;
 			}
-			else if(vertices_status[neighbor].status_code == UNDISCOVERED_GOAL)
+			else if(neighbor_status.status_code == UNDISCOVERED_GOAL)
 			{
-				vertices_status[neighbor].status_code = OPEN_GOAL;				
+				neighbor_status.status_code = OPEN_GOAL;
+				is_discovered = false;
 			}
-			else /*if(vertices_status[neighbor].status_code == OPEN || vertices_status[neighbor].status_code == OPEN_GOAL)*/
+			if(!is_discovered)
+			{
+				neighbor_status.heuristic_cost_from_this_to_goal = min_heuristic_cost(graph, neighbor, heuristic_goal_group, heuristic, statistics);
+				if(heuristic_factor != 1.0)
+					neighbor_status.heuristic_cost_from_this_to_goal = inflate_cost(neighbor_status.heuristic_cost_from_this_to_goal, heuristic_factor);
+				statistics.on_discover();
+			}
+			bool is_queued = is_discovered;
+			if(TOpenList::is_reopening && neighbor_status.status_code == CLOSED)
+			{
+				neighbor_status.status_code = OPEN;
+				is_queued = false;
+			}
+
+			neighbor_status.parent = open_vertex.vertex;
+			neighbor_status.cost_from_start_to_this = cost_from_start_to_neighbor;
+			neighbor_status.heuristic_cost_from_start_to_goal =
+				neighbor_status.cost_from_start_to_this + neighbor_status.heuristic_cost_from_this_to_goal;
+			if(neighbor_status.status_code == OPEN_GOAL &&
+				(best_goal == -1 || cost_from_start_to_neighbor < context.get_status(best_goal).cost_from_start_to_this))
 			{
-				open_vertices_queue.remove(vertices_status[neighbor]);
+				best_goal = neighbor;
 			}
 
-			vertices_status[neighbor].parent = open_vertex.vertex;
-			vertices_status[neighbor].cost_from_start_to_this = cost_from_start_to_neighbor;
-			vertices_status[neighbor].heuristic_cost_from_this_to_goal = min_heuristic_cost(graph, neighbor, goal_group, heuristic);
-			vertices_status[neighbor].heuristic_cost_from_start_to_goal =
-				vertices_status[neighbor].cost_from_start_to_this + vertices_status[neighbor].heuristic_cost_from_this_to_goal;
-			open_vertices_queue.push(vertices_status[neighbor]);
+			if(is_queued)
+			{
+				open_list.decrease_key(neighbor, neighbor_status.heuristic_cost_from_start_to_goal,
+					neighbor_status.heuristic_cost_from_this_to_goal);
+				statistics.on_decrease_key();
+			}
+			else
+			{
+				open_list.push(neighbor, neighbor_status.heuristic_cost_from_start_to_goal,
+					neighbor_status.heuristic_cost_from_this_to_goal);
+				statistics.on_push();
+			}
 		}
 	}
 
-	return false;
+	return PATH_NOT_FOUND;
 }
 
-//          ,   .
-// ,  goal_group  .
+//  cost,   factor ;     .
 template<typename TVertexValue, typename TEdgeWeight>
-TEdgeWeight AStarSearch<TVertexValue,TEdgeWeight>::min_heuristic_cost(const Graph<TVertexValue, TEdgeWeight>& graph, const int start,
-	const std::set<int> goal_group,	const AStarDefaultHeuristic& heuristic)
-{	
-	TEdgeWeight current_weight;
-	TEdgeWeight min_weight = heuristic.get_cost(graph, start, *goal_group.begin());
-	for(std::set<int>::iterator i=++goal_group.begin(); i != goal_group.end(); ++i)
+inline TEdgeWeight AStarSearch<TVertexValue, TEdgeWeight>::inflate_cost(const TEdgeWeight& cost, const double factor)
+{
+	return static_cast<TEdgeWeight>(cost*factor);
+}
+
+//     vertex    .
+template<typename TVertexValue, typename TEdgeWeight>
+void AStarSearch<TVertexValue, TEdgeWeight>::get_path(SearchContext& context, int vertex, std::list<int>& path)
+{
+	path.clear();
+	int current_vertex = vertex;
+	while (current_vertex != -1)
 	{
-		current_weight = heuristic.get_cost(graph, start, *i);
-		min_weight = current_weight < min_weight ? current_weight : min_weight;
+		path.push_front(current_vertex);
+		current_vertex = context.get_status(current_vertex).parent;
+	}
+}
+
+//      .       , 
+//    ;     ,      
+//   .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+TEdgeWeight AStarSearch<TVertexValue, TEdgeWeight>::get_path_cost(const TGraph& graph, const std::list<int>& path)
+{
+	TEdgeWeight path_cost = TEdgeWeight();
+	for(std::list<int>::const_iterator i=path.begin(), j=std::next(path.begin()); j != path.end(); ++i, ++j)
+	{
+		TEdgeWeight weight = TEdgeWeight();
+		graph.get_edge_weight(*i, *j, weight);
+		path_cost += weight;
+	}
+	return path_cost;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+void AStarSearch<TVertexValue, TEdgeWeight>::FocalOpenList::reset(int num_vertices)
+{
+	ordered_queue.resize(num_vertices);
+	pending_queue.resize(num_vertices);
+	focal_queue.resize(num_vertices);
+	ordered_queue.clear();
+	pending_queue.clear();
+	focal_queue.clear();
+	focal_bound = TEdgeWeight();
+}
+
+//    ,        f,  
+//       h (  h -   f).
+template<typename TVertexValue, typename TEdgeWeight>
+int AStarSearch<TVertexValue, TEdgeWeight>::FocalOpenList::pop()
+{
+	focal_bound = inflate_cost(ordered_queue.top_priority(), focal_factor);
+	while(!pending_queue.empty() && !(focal_bound < pending_queue.top_priority().first))
+	{
+		int vertex = pending_queue.top();
+		std::pair<TEdgeWeight, TEdgeWeight> priority = pending_queue.top_priority();
+		pending_queue.pop();
+		focal_queue.push(vertex, std::make_pair(priority.second, priority.first));
+	}
+	int vertex = focal_queue.top();
+	focal_queue.pop();
+	ordered_queue.remove(vertex);
+	return vertex;
+}
+
+//      ,    (   f = 0)   pending_queue.
+template<typename TVertexValue, typename TEdgeWeight>
+void AStarSearch<TVertexValue, TEdgeWeight>::FocalOpenList::push(
+	int vertex, const TEdgeWeight& cost, const TEdgeWeight& heuristic_cost)
+{
+	ordered_queue.push(vertex, cost);
+	if(focal_bound < cost)
+		pending_queue.push(vertex, std::make_pair(cost, heuristic_cost));
+	else
+		focal_queue.push(vertex, std::make_pair(heuristic_cost, cost));
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+void AStarSearch<TVertexValue, TEdgeWeight>::FocalOpenList::decrease_key(
+	int vertex, const TEdgeWeight& cost, const TEdgeWeight& heuristic_cost)
+{
+	ordered_queue.decrease_key(vertex, cost);
+	if(focal_queue.contains(vertex))
+		focal_queue.decrease_key(vertex, std::make_pair(heuristic_cost, cost));
+	else
+		pending_queue.decrease_key(vertex, std::make_pair(cost, heuristic_cost));
+}
+
+//  :     -        .
+//      ,      (set_edge_weight 
+//    ),   ,   v   w,    w -> v
+//    v (NeighborRange::reverse_weight):       ,
+//   -      ,     w.
+//      :  pt(v) -    v
+//    ,  ps(v) -   ,     
+//  d(v) + (pt(v) - ps(v))/2,   -  d(v) + (ps(v) - pt(v))/2.   
+//         ,    ,
+//              .
+//      ,   .
+//        .
+//     (),       .
+//       v  get_min_reverse_cost,   heuristic(s, v), 
+//    ,  ALT      .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_path_bidirectional(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	BidirectionalSearchContext context;
+	return find_shortest_path_bidirectional(graph, start_group, goal_group, heuristic, context,
+		shortest_path, shortest_path_cost);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_path_bidirectional(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, BidirectionalSearchContext& context,
+	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	NoSearchStatistics statistics;
+	return find_shortest_path_bidirectional(graph, start_group, goal_group, heuristic, context, statistics,
+		shortest_path, shortest_path_cost);
+}
+
+//     ;     .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_path_bidirectional(
+	const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, BidirectionalSearchContext& context, TStatisticsPolicy& statistics,
+	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	if(start_group.empty() || goal_group.empty())
+		return false;
+
+	SearchStatisticsScope<TStatisticsPolicy> statistics_scope(statistics);
+
+	const int num_vertices = graph.get_num_vertices();
+	context.forward.reset(num_vertices);
+	context.backward.reset(num_vertices);
+
+	//   heuristic_cost_from_this_to_goal       ,
+	//   heuristic_cost_from_start_to_goal -      .
+	SearchContext* contexts[2] = { &context.forward, &context.backward };
+	const std::set<int>* groups[2] = { &get_heuristic_group(heuristic, start_group), &get_heuristic_group(heuristic, goal_group) };
+	for(int direction=0; direction < 2; ++direction)
+		for(std::set<int>::const_iterator i=groups[direction]->begin(); i != groups[direction]->end(); ++i)
+		{
+			int vertex = *i;
+			if(vertex >= num_vertices || vertex < 0)
+				return false;
+
+			VertexStatus& vertex_status = contexts[direction]->get_status(vertex);
+			vertex_status.vertex = vertex;
+			vertex_status.status_code = OPEN;
+			vertex_status.cost_from_start_to_this = TEdgeWeight();
+			vertex_status.heuristic_cost_from_this_to_goal =
+				get_bidirectional_potential(graph, vertex, *groups[0], *groups[1], direction, heuristic, statistics);
+			vertex_status.heuristic_cost_from_start_to_goal = vertex_status.heuristic_cost_from_this_to_goal;
+			contexts[direction]->open_vertices_queue.push(vertex, vertex_status.heuristic_cost_from_start_to_goal);
+			statistics.on_discover();
+			statistics.on_push();
+		}
+
+	bool is_found = false;
+	int meeting_vertex = -1;
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+		if(goal_group.count(*i) != 0)
+		{
+			is_found = true;
+			meeting_vertex = *i;
+			shortest_path_cost = TEdgeWeight();
+			break;
+		}
+
+	while(!context.forward.open_vertices_queue.empty() && !context.backward.open_vertices_queue.empty())
+	{
+		TEdgeWeight forward_key = context.forward.open_vertices_queue.top_priority();
+		TEdgeWeight backward_key = context.backward.open_vertices_queue.top_priority();
+		if(is_found && forward_key + backward_key >= shortest_path_cost + shortest_path_cost)
+			break;
+
+		//     ,     .
+		int direction = backward_key < forward_key ? 1 : 0;
+		SearchContext& this_context = *contexts[direction];
+		SearchContext& other_context = *contexts[1 - direction];
+
+		VertexStatus& open_vertex = this_context.get_status(this_context.open_vertices_queue.top());
+		this_context.open_vertices_queue.pop();
+		++this_context.num_settled;
+		open_vertex.status_code = CLOSED;
+		statistics.on_pop();
+		statistics.on_settle();
+
+		typename TGraph::NeighborRange neighbors;
+		graph.get_neighbor_range(open_vertex.vertex, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			statistics.on_relax();
+			int neighbor = neighbors.destination(i);
+			VertexStatus& neighbor_status = this_context.get_status(neighbor);
+			if(neighbor_status.status_code == CLOSED)
+				continue;
+
+			//        ,     neighbor -> .
+			TEdgeWeight edge_weight = direction == 0 ? neighbors.weight(i) : neighbors.reverse_weight(i);
+			TEdgeWeight cost_to_neighbor = open_vertex.cost_from_start_to_this + edge_weight;
+			if(neighbor_status.status_code == OPEN && cost_to_neighbor >= neighbor_status.cost_from_start_to_this)
+				continue;
+
+			VertexStatus& neighbor_other_status = other_context.get_status(neighbor);
+			bool is_discovered = neighbor_status.status_code == OPEN;
+			if(!is_discovered)
+			{
+				neighbor_status.vertex = neighbor;
+				neighbor_status.status_code = OPEN;
+				//     , ,  
+				//    ,     .
+				if(neighbor_other_status.status_code != UNDISCOVERED)
+					neighbor_status.heuristic_cost_from_this_to_goal = -neighbor_other_status.heuristic_cost_from_this_to_goal;
+				else
+					neighbor_status.heuristic_cost_from_this_to_goal =
+						get_bidirectional_potential(graph, neighbor, *groups[0], *groups[1], direction, heuristic, statistics);
+				statistics.on_discover();
+			}
+
+			neighbor_status.parent = open_vertex.vertex;
+			neighbor_status.cost_from_start_to_this = cost_to_neighbor;
+			neighbor_status.heuristic_cost_from_start_to_goal =
+				cost_to_neighbor + cost_to_neighbor + neighbor_status.heuristic_cost_from_this_to_goal;
+			if(is_discovered)
+			{
+				this_context.open_vertices_queue.decrease_key(neighbor, neighbor_status.heuristic_cost_from_start_to_goal);
+				statistics.on_decrease_key();
+			}
+			else
+			{
+				this_context.open_vertices_queue.push(neighbor, neighbor_status.heuristic_cost_from_start_to_goal);
+				statistics.on_push();
+			}
+
+			if(neighbor_other_status.status_code != UNDISCOVERED)
+			{
+				TEdgeWeight path_cost = cost_to_neighbor + neighbor_other_status.cost_from_start_to_this;
+				if(!is_found || path_cost < shortest_path_cost)
+				{
+					is_found = true;
+					meeting_vertex = neighbor;
+					shortest_path_cost = path_cost;
+				}
+			}
+		}
+	}
+
+	if(!is_found)
+		return false;
+
+	shortest_path.clear();
+	for(int current_vertex=meeting_vertex; current_vertex != -1; current_vertex=context.forward.get_status(current_vertex).parent)
+		shortest_path.push_front(current_vertex);
+	for(int current_vertex=context.backward.get_status(meeting_vertex).parent; current_vertex != -1;
+		current_vertex=context.backward.get_status(current_vertex).parent)
+		shortest_path.push_back(current_vertex);
+	return true;
+}
+
+//  :    ( ,  )  queries
+//   results[i]  find_shortest_path.
+//     ,    ,     .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic>
+void AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_paths(
+	const TGraph& graph, const std::vector<SearchQuery>& queries,
+	const THeuristic& heuristic, std::vector<SearchResult>& results)
+{
+	ThreadPool pool;
+	find_shortest_paths(graph, queries, heuristic, pool, results);
+}
+
+//      pool.
+//        ,          .
+//     SearchContext,       .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic>
+void AStarSearch<TVertexValue,TEdgeWeight>::find_shortest_paths(
+	const TGraph& graph, const std::vector<SearchQuery>& queries,
+	const THeuristic& heuristic, ThreadPool& pool, std::vector<SearchResult>& results)
+{
+	results.assign(queries.size(), SearchResult());
+	std::vector<SearchContext> contexts(pool.get_num_threads());
+	pool.parallel_for(queries.size(), [&](size_t index, size_t worker)
+	{
+		SearchResult& result = results[index];
+		result.is_found = find_shortest_path(graph, queries[index].first, queries[index].second,
+			heuristic, contexts[worker], result.shortest_path, result.shortest_path_cost);
+	});
+}
+
+//        sources    targets
+// (    -      , <<  >>).
+//  sources.size()*targets.size()         ,
+//  ,        ;    
+//      .     ,    .
+//  false,     .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_distance_matrix(
+	const TGraph& graph, const std::vector<int>& sources, const std::vector<int>& targets,
+	DistanceMatrix<TEdgeWeight>& matrix)
+{
+	ThreadPool pool;
+	return find_distance_matrix(graph, sources, targets, pool, matrix);
+}
+
+//      pool:     ,
+//     SearchContext.       .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_distance_matrix(
+	const TGraph& graph, const std::vector<int>& sources, const std::vector<int>& targets,
+	ThreadPool& pool, DistanceMatrix<TEdgeWeight>& matrix)
+{
+	const int num_vertices = graph.get_num_vertices();
+	for(size_t i=0; i < sources.size(); ++i)
+		if(sources[i] >= num_vertices || sources[i] < 0)
+			return false;
+	for(size_t i=0; i < targets.size(); ++i)
+		if(targets[i] >= num_vertices || targets[i] < 0)
+			return false;
+
+	matrix.reset(static_cast<int>(sources.size()), static_cast<int>(targets.size()));
+	if(sources.empty() || targets.empty())
+		return true;
+
+	//    :  ,    .
+	std::vector<int> target_vertices(targets);
+	std::sort(target_vertices.begin(), target_vertices.end());
+	target_vertices.erase(std::unique(target_vertices.begin(), target_vertices.end()), target_vertices.end());
+
+	std::vector<SearchContext> contexts(pool.get_num_threads());
+	pool.parallel_for(sources.size(), [&](size_t index, size_t worker)
+	{
+		find_distance_row(graph, sources[index], targets, target_vertices, contexts[worker],
+			matrix, static_cast<int>(index));
+	});
+	return true;
+}
+
+//    source     target_vertices;   source_index .
+//       ,   
+//       ,  .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+void AStarSearch<TVertexValue,TEdgeWeight>::find_distance_row(const TGraph& graph, const int source,
+	const std::vector<int>& targets, const std::vector<int>& target_vertices, SearchContext& context,
+	DistanceMatrix<TEdgeWeight>& matrix, const int source_index)
+{
+	context.reset(graph.get_num_vertices());
+	for(size_t i=0; i < target_vertices.size(); ++i)
+	{
+		VertexStatus& target_status = context.get_status(target_vertices[i]);
+		target_status.vertex = target_vertices[i];
+		target_status.status_code = UNDISCOVERED_GOAL;
+	}
+	size_t num_remaining = target_vertices.size();
+
+	typename SearchPriorityQueue<TEdgeWeight>::type& open_vertices_queue = context.open_vertices_queue;
+	VertexStatus& source_status = context.get_status(source);
+	source_status.vertex = source;
+	source_status.status_code = source_status.status_code == UNDISCOVERED_GOAL ? OPEN_GOAL : OPEN;
+	source_status.cost_from_start_to_this = TEdgeWeight();
+	open_vertices_queue.push(source, TEdgeWeight());
+
+	while(!open_vertices_queue.empty())
+	{
+		VertexStatus& open_vertex = context.get_status(open_vertices_queue.top());
+		open_vertices_queue.pop();
+		++context.num_settled;
+
+		if(open_vertex.status_code == OPEN_GOAL)
+			--num_remaining;
+		open_vertex.status_code = CLOSED;
+		if(num_remaining == 0)
+			break;
+
+		typename TGraph::NeighborRange neighbors;
+		graph.get_neighbor_range(open_vertex.vertex, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			int neighbor = neighbors.destination(i);
+			VertexStatus& neighbor_status = context.get_status(neighbor);
+			if(neighbor_status.status_code == CLOSED)
+				continue;
+
+			TEdgeWeight cost_from_start_to_neighbor = open_vertex.cost_from_start_to_this + neighbors.weight(i);
+			if(neighbor_status.status_code == UNDISCOVERED || neighbor_status.status_code == UNDISCOVERED_GOAL)
+			{
+				neighbor_status.vertex = neighbor;
+				neighbor_status.status_code = neighbor_status.status_code == UNDISCOVERED_GOAL ? OPEN_GOAL : OPEN;
+				neighbor_status.parent = open_vertex.vertex;
+				neighbor_status.cost_from_start_to_this = cost_from_start_to_neighbor;
+				open_vertices_queue.push(neighbor, cost_from_start_to_neighbor);
+			}
+			else if(cost_from_start_to_neighbor < neighbor_status.cost_from_start_to_this)
+			{
+				neighbor_status.parent = open_vertex.vertex;
+				neighbor_status.cost_from_start_to_this = cost_from_start_to_neighbor;
+				open_vertices_queue.decrease_key(neighbor, cost_from_start_to_neighbor);
+			}
+		}
+	}
+
+	for(size_t i=0; i < targets.size(); ++i)
+	{
+		const VertexStatus& target_status = context.get_status(targets[i]);
+		if(target_status.status_code == CLOSED)
+			matrix.set_cost(source_index, static_cast<int>(i), target_status.cost_from_start_to_this);
+	}
+}
+
+// ,           budgets (),
+//  ,     (. Isochrone).      
+//        ,    :
+//      ,     - 
+//   .        .
+//  false,      .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_reachable(
+	const TGraph& graph, const std::set<int>& start_group, const std::vector<TEdgeWeight>& budgets,
+	Isochrone<TEdgeWeight>& isochrone)
+{
+	SearchContext context;
+	return find_reachable(graph, start_group, budgets, context, isochrone);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+bool AStarSearch<TVertexValue,TEdgeWeight>::find_reachable(
+	const TGraph& graph, const std::set<int>& start_group, const std::vector<TEdgeWeight>& budgets,
+	SearchContext& context, Isochrone<TEdgeWeight>& isochrone)
+{
+	isochrone.reset(budgets);
+	const int num_vertices = graph.get_num_vertices();
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+		if(*i >= num_vertices || *i < 0)
+			return false;
+
+	context.reset(num_vertices);
+	const int num_budgets = isochrone.get_num_budgets();
+	if(num_budgets == 0 || isochrone.get_budget(num_budgets - 1) < TEdgeWeight())
+		return true;
+	const TEdgeWeight max_budget = isochrone.get_budget(num_budgets - 1);
+
+	typename SearchPriorityQueue<TEdgeWeight>::type& open_vertices_queue = context.open_vertices_queue;
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+	{
+		VertexStatus& start_status = context.get_status(*i);
+		start_status.vertex = *i;
+		start_status.status_code = OPEN;
+		start_status.cost_from_start_to_this = TEdgeWeight();
+		open_vertices_queue.push(*i, TEdgeWeight());
+	}
+
+	// first_budget -  ,     ;    .
+	int first_budget = 0;
+	while(!open_vertices_queue.empty())
+	{
+		VertexStatus& open_vertex = context.get_status(open_vertices_queue.top());
+		if(max_budget < open_vertex.cost_from_start_to_this)
+			break;
+		open_vertices_queue.pop();
+		++context.num_settled;
+		open_vertex.status_code = CLOSED;
+
+		const TEdgeWeight cost = open_vertex.cost_from_start_to_this;
+		isochrone.add_vertex(open_vertex.vertex, open_vertex.parent, cost);
+		while(isochrone.get_budget(first_budget) < cost)
+			++first_budget;
+
+		typename TGraph::NeighborRange neighbors;
+		graph.get_neighbor_range(open_vertex.vertex, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			int neighbor = neighbors.destination(i);
+			TEdgeWeight cost_from_start_to_neighbor = cost + neighbors.weight(i);
+			for(int k=first_budget; k < num_budgets && isochrone.get_budget(k) < cost_from_start_to_neighbor; ++k)
+				isochrone.add_frontier_edge(k, open_vertex.vertex, neighbor, isochrone.get_budget(k) - cost);
+
+			VertexStatus& neighbor_status = context.get_status(neighbor);
+			if(neighbor_status.status_code == CLOSED || max_budget < cost_from_start_to_neighbor)
+				continue;
+			if(neighbor_status.status_code == UNDISCOVERED)
+			{
+				neighbor_status.vertex = neighbor;
+				neighbor_status.status_code = OPEN;
+				neighbor_status.parent = open_vertex.vertex;
+				neighbor_status.cost_from_start_to_this = cost_from_start_to_neighbor;
+				open_vertices_queue.push(neighbor, cost_from_start_to_neighbor);
+			}
+			else if(cost_from_start_to_neighbor < neighbor_status.cost_from_start_to_this)
+			{
+				neighbor_status.parent = open_vertex.vertex;
+				neighbor_status.cost_from_start_to_this = cost_from_start_to_neighbor;
+				open_vertices_queue.decrease_key(neighbor, cost_from_start_to_neighbor);
+			}
+		}
+	}
+	return true;
+}
+
+//          ; ,  goal_group  .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+TEdgeWeight AStarSearch<TVertexValue,TEdgeWeight>::min_heuristic_cost(const TGraph& graph, const int start,
+	const std::set<int>& goal_group, const THeuristic& heuristic, TStatisticsPolicy& statistics)
+{
+	if constexpr(IsZeroHeuristic<THeuristic>::value)
+		return TEdgeWeight();
+	else
+	{
+		statistics.begin_heuristic();
+		TEdgeWeight cost = heuristic.get_min_cost(graph, start, goal_group);
+		statistics.end_heuristic();
+		return cost;
+	}
+}
+
+//      : pt(v) - ps(v)   
+//  ps(v) - pt(v)  ,  pt(v) -    v   ,
+//  ps(v) -       v (get_min_reverse_cost).
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph, typename THeuristic, typename TStatisticsPolicy>
+TEdgeWeight AStarSearch<TVertexValue,TEdgeWeight>::get_bidirectional_potential(const TGraph& graph, const int vertex,
+	const std::set<int>& start_group, const std::set<int>& goal_group, const int direction,
+	const THeuristic& heuristic, TStatisticsPolicy& statistics)
+{
+	if constexpr(IsZeroHeuristic<THeuristic>::value)
+		return TEdgeWeight();
+	else
+	{
+		statistics.begin_heuristic();
+		TEdgeWeight potential = heuristic.get_min_cost(graph, vertex, goal_group) -
+			heuristic.get_min_reverse_cost(graph, vertex, start_group);
+		statistics.end_heuristic();
+		return direction == 0 ? potential : -potential;
 	}
-	return min_weight;
 }
 #endif
\ No newline at end of file
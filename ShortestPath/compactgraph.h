@@ -0,0 +1,282 @@
+#pragma once
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+#include "graph.h"
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+class CompactGraph;
+
+//     :         .
+//      ,   CSREdgeRange:   ,   ,    .
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+class CompactEdgeRange
+{
+	const CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>* graph;
+	int vertex;
+	const int* destinations;
+	const TQuantizedWeight* weights;
+	const TQuantizedWeight* reverse_weights;
+	TEdgeWeight scale;
+	size_t num_edges;
+public:
+	CompactEdgeRange() : graph(nullptr), vertex(-1), destinations(nullptr), weights(nullptr), reverse_weights(nullptr),
+		scale(TEdgeWeight()), num_edges(0) { }
+	CompactEdgeRange(const CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>* graph, int vertex,
+		const int* destinations, const TQuantizedWeight* weights, const TQuantizedWeight* reverse_weights,
+		const TEdgeWeight& scale, size_t num_edges)
+		: graph(graph), vertex(vertex), destinations(destinations), weights(weights), reverse_weights(reverse_weights),
+		scale(scale), num_edges(num_edges) { }
+	size_t size() const { return num_edges; }
+	int destination(size_t i) const { return destinations[i]; }
+	TEdgeWeight weight(size_t i) const { return static_cast<TEdgeWeight>(weights[i])*scale; }
+	TEdgeWeight reverse_weight(size_t i) const;
+};
+
+//      CSR    .
+//       q  TQuantizedWeight (16  32 ),    -
+// q*scale,  scale -    ,  ,   q   .
+//   ,      : , 
+// ( )   ,      ,  A*    ,
+//    .     scale (. get_scale),  
+//         scale   .
+//  ,     TQuantizedWeight,   (scale = 1).
+//    .  std::uint16_t   6   12  CSRGraph<point,double>
+//  16  Graph<point,double>;    -    ,
+//        .   ,    CSRGraph,
+//  ( 2   )         .
+//      AStarSearch     NeighborRange::weight.
+//     Graph  CSRGraph.
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight = std::uint16_t>
+class CompactGraph
+{
+	static_assert(std::is_integral<TQuantizedWeight>::value && std::is_unsigned<TQuantizedWeight>::value,
+		"Quantized weights must be of an unsigned integral type.");
+
+	struct Arrays
+	{
+		std::vector<std::uint64_t> offsets;
+		std::vector<int> destinations;
+		std::vector<TQuantizedWeight> weights;
+		std::vector<TQuantizedWeight> reverse_weights;
+		std::vector<TVertexValue> values;
+	};
+
+	std::shared_ptr<const Arrays> storage;
+	TEdgeWeight scale;
+	int num_vertices;
+	bool is_symmetric;
+	std::uint64_t version;
+
+	static TEdgeWeight get_scale(const TEdgeWeight& max_weight);
+	static TQuantizedWeight quantize(const TEdgeWeight& weight, const TEdgeWeight& scale);
+public:
+	typedef CompactEdgeRange<TVertexValue, TEdgeWeight, TQuantizedWeight> NeighborRange;
+
+	template<typename TGraph>
+	explicit CompactGraph(const TGraph& graph, bool store_reverse_weights = false);
+	int get_num_vertices() const;
+	size_t get_num_edges() const;
+	//  ,          (. Graph::get_version).
+	std::uint64_t get_version() const { return version; }
+	//  :         scale.
+	TEdgeWeight get_scale() const { return scale; }
+	//     ,  ,  (. CSRGraph).
+	bool has_symmetric_weights() const { return is_symmetric; }
+	bool get_neighbor_range(const int vertex, NeighborRange& neighbors) const;
+	bool contains_edge(const int vertex_origin, const int vertex_destination) const;
+	bool get_edge_weight(const int vertex_origin, const int vertex_destination, TEdgeWeight& weight) const;
+	bool get_vertex_value(const int vertex, TVertexValue& value) const;
+	void print(std::ostream& out_stream) const;
+};
+
+//        (Graph, CSRGraph       ):
+//   ,      ,   ,  .
+//    ,   store_reverse_weights    .
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+template<typename TGraph>
+CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::CompactGraph(const TGraph& graph, bool store_reverse_weights)
+	: scale(TEdgeWeight()), num_vertices(graph.get_num_vertices()), is_symmetric(true), version(get_next_graph_version())
+{
+	std::shared_ptr<Arrays> arrays = std::make_shared<Arrays>();
+	typename TGraph::NeighborRange neighbors;
+
+	TEdgeWeight max_weight = TEdgeWeight();
+	arrays->offsets.resize(num_vertices + 1);
+	arrays->offsets[0] = 0;
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		arrays->offsets[v+1] = arrays->offsets[v] + neighbors.size();
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			max_weight = max_weight < neighbors.weight(i) ? neighbors.weight(i) : max_weight;
+			is_symmetric = is_symmetric &&
+				(neighbors.destination(i) == v || neighbors.weight(i) == neighbors.reverse_weight(i));
+		}
+	}
+	scale = get_scale(max_weight);
+
+	arrays->destinations.resize(static_cast<size_t>(arrays->offsets[num_vertices]));
+	arrays->weights.resize(static_cast<size_t>(arrays->offsets[num_vertices]));
+	if(store_reverse_weights && !is_symmetric)
+		arrays->reverse_weights.resize(static_cast<size_t>(arrays->offsets[num_vertices]));
+	arrays->values.resize(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			arrays->destinations[static_cast<size_t>(arrays->offsets[v]) + i] = neighbors.destination(i);
+			arrays->weights[static_cast<size_t>(arrays->offsets[v]) + i] = quantize(neighbors.weight(i), scale);
+			if(!arrays->reverse_weights.empty())
+				arrays->reverse_weights[static_cast<size_t>(arrays->offsets[v]) + i] =
+					quantize(neighbors.reverse_weight(i), scale);
+		}
+		graph.get_vertex_value(v, arrays->values[v]);
+	}
+	storage = arrays;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+inline TEdgeWeight CompactEdgeRange<TVertexValue, TEdgeWeight, TQuantizedWeight>::reverse_weight(size_t i) const
+{
+	if(reverse_weights != nullptr)
+		return static_cast<TEdgeWeight>(reverse_weights[i])*scale;
+	TEdgeWeight weight = static_cast<TEdgeWeight>(weights[i])*scale;
+	graph->get_edge_weight(destinations[i], vertex, weight);
+	return weight;
+}
+
+//  ,       TQuantizedWeight.
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+TEdgeWeight CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::get_scale(const TEdgeWeight& max_weight)
+{
+	const TQuantizedWeight max_quantized = std::numeric_limits<TQuantizedWeight>::max();
+	if constexpr(std::is_integral<TEdgeWeight>::value)
+	{
+		//   64 :   TQuantizedWeight     TEdgeWeight.
+		std::uint64_t weight = max_weight < TEdgeWeight() ? 0 : static_cast<std::uint64_t>(max_weight);
+		if(weight <= max_quantized)
+			return static_cast<TEdgeWeight>(1);
+		return static_cast<TEdgeWeight>(weight/max_quantized + (weight % max_quantized != 0 ? 1 : 0));
+	}
+	else
+	{
+		if(!(TEdgeWeight() < max_weight))
+			return static_cast<TEdgeWeight>(1);
+		TEdgeWeight result = max_weight/static_cast<TEdgeWeight>(max_quantized);
+		//  ,  max_quantized*result     max_weight.
+		while(static_cast<TEdgeWeight>(max_quantized)*result < max_weight)
+			result = std::nextafter(result, std::numeric_limits<TEdgeWeight>::max());
+		return result;
+	}
+}
+
+//  q,   q*scale   weight.
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+TQuantizedWeight CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::quantize(
+	const TEdgeWeight& weight, const TEdgeWeight& scale)
+{
+	const TQuantizedWeight max_quantized = std::numeric_limits<TQuantizedWeight>::max();
+	if(!(TEdgeWeight() < weight))
+		return 0;
+	if constexpr(std::is_integral<TEdgeWeight>::value)
+	{
+		return static_cast<TQuantizedWeight>(weight/scale + (weight % scale != 0 ? 1 : 0));
+	}
+	else
+	{
+		TEdgeWeight quotient = std::ceil(weight/scale);
+		TQuantizedWeight result = quotient < static_cast<TEdgeWeight>(max_quantized) ?
+			static_cast<TQuantizedWeight>(quotient) : max_quantized;
+		while(result < max_quantized && static_cast<TEdgeWeight>(result)*scale < weight)
+			++result;
+		return result;
+	}
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+int CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::get_num_vertices() const
+{
+	return num_vertices;
+}
+
+//      ;     .
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+size_t CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::get_num_edges() const
+{
+	return storage->destinations.size();
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+bool CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::get_neighbor_range(
+	const int vertex, NeighborRange& neighbors) const
+{
+	if(vertex >= num_vertices || vertex < 0)
+		return false;
+	size_t first = static_cast<size_t>(storage->offsets[vertex]);
+	size_t count = static_cast<size_t>(storage->offsets[vertex+1] - storage->offsets[vertex]);
+	//           .
+	const TQuantizedWeight* reverse_weights = !storage->reverse_weights.empty() ? &storage->reverse_weights[first] :
+		is_symmetric ? &storage->weights[first] : nullptr;
+	neighbors = count == 0 ? NeighborRange() :
+		NeighborRange(this, vertex, &storage->destinations[first], &storage->weights[first], reverse_weights, scale, count);
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+bool CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::contains_edge(
+	const int vertex_origin, const int vertex_destination) const
+{
+	TEdgeWeight weight;
+	return get_edge_weight(vertex_origin, vertex_destination, weight);
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+bool CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::get_edge_weight(
+	const int vertex_origin, const int vertex_destination, TEdgeWeight& weight) const
+{
+	if(vertex_origin >= num_vertices || vertex_destination >= num_vertices
+		|| vertex_origin < 0 || vertex_destination < 0)
+		return false;
+
+	for(size_t i=static_cast<size_t>(storage->offsets[vertex_origin]); i < storage->offsets[vertex_origin+1]; ++i)
+		if(storage->destinations[i] == vertex_destination)
+		{
+			weight = static_cast<TEdgeWeight>(storage->weights[i])*scale;
+			return true;
+		}
+
+	return false;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+bool CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::get_vertex_value(
+	const int vertex, TVertexValue& value) const
+{
+	if(vertex >= num_vertices || vertex < 0)
+		return false;
+	value = storage->values[vertex];
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TQuantizedWeight>
+inline void CompactGraph<TVertexValue, TEdgeWeight, TQuantizedWeight>::print(std::ostream& out_stream) const
+{
+	for(int i=0; i < num_vertices; ++i)
+	{
+		out_stream << i << " <--> ";
+		for(size_t j=static_cast<size_t>(storage->offsets[i]); j < storage->offsets[i+1]; ++j)
+			out_stream << storage->destinations[j] << " ";
+		out_stream << std::endl;
+	}
+}
+#endif
@@ -0,0 +1,699 @@
+#pragma once
+#ifndef CONTRACTION_H
+#define CONTRACTION_H
+
+#include <set>
+#include <list>
+#include <vector>
+#include "graph.h"
+#include "pqueue.h"
+#include "distmatrix.h"
+#include "threadpool.h"
+
+//   (contraction hierarchies)        .
+//      <<>>:    ,   
+//     ,     - (shortcuts),
+//         .   ( )
+//         .
+//       ,      <<>> -
+//     ,      .
+//    ,       A*.
+//       (Graph::set_edge_weight     ), 
+//     :  u -> w  v    
+// ,              -  
+//  (  )    ( ).
+//     ;       .
+template<typename TVertexValue, typename TEdgeWeight>
+class ContractionHierarchy
+{
+public:
+	class QueryContext;
+
+	explicit ContractionHierarchy(const Graph<TVertexValue, TEdgeWeight>& graph);
+	int get_num_vertices() const;
+	int get_rank(const int vertex) const;
+	size_t get_num_shortcuts() const;
+	bool find_shortest_path(const std::set<int>& start_group, const std::set<int>& goal_group,
+		std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost) const;
+	bool find_shortest_path(const std::set<int>& start_group, const std::set<int>& goal_group,
+		QueryContext& context, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost) const;
+	bool find_distance_matrix(const std::vector<int>& sources, const std::vector<int>& targets,
+		DistanceMatrix<TEdgeWeight>& matrix) const;
+	bool find_distance_matrix(const std::vector<int>& sources, const std::vector<int>& targets,
+		ThreadPool& pool, DistanceMatrix<TEdgeWeight>& matrix) const;
+
+private:
+	//  .  - middle -  ,    ,  -1.
+	//     destination   ,    .
+	struct Arc
+	{
+		int destination;
+		TEdgeWeight weight;
+		int middle;
+		Arc(int destination, TEdgeWeight weight, int middle) : destination(destination), weight(weight), middle(middle) { }
+	};
+
+	//    :         target_index   .
+	struct BucketEntry
+	{
+		int vertex;
+		int target_index;
+		TEdgeWeight cost;
+	};
+
+	class Builder;
+
+	//   v       [offsets[side][v], offsets[side][v+1])  upward_arcs[side]:
+	//  side = 0 -  v -> destination (    ),  side = 1 -  destination -> v
+	//     (       ).
+	std::vector<size_t> offsets[2];
+	std::vector<Arc> upward_arcs[2];
+	std::vector<int> ranks;
+	size_t num_shortcuts;
+	int num_vertices;
+
+	const Arc* find_arc(const int vertex_origin, const int vertex_destination) const;
+	void search_upward(const int source, const int side, QueryContext& context) const;
+	void unpack_arc(const int vertex_origin, const int vertex_destination, std::list<int>& path) const;
+};
+
+//   :             .
+//          ;   -   .
+template<typename TVertexValue, typename TEdgeWeight>
+class ContractionHierarchy<TVertexValue, TEdgeWeight>::QueryContext
+{
+	friend class ContractionHierarchy<TVertexValue, TEdgeWeight>;
+
+	struct Side
+	{
+		std::vector<TEdgeWeight> costs;
+		std::vector<int> parents;
+		std::vector<unsigned int> generations;
+		IndexedPriorityQueue<TEdgeWeight> queue;
+	};
+
+	Side sides[2];
+	unsigned int generation;
+	// ,       (search_upward),   .
+	std::vector<int> settled;
+
+	void reset(int num_vertices);
+	bool is_reached(int side, int vertex) const { return sides[side].generations[vertex] == generation; }
+public:
+	QueryContext() : generation(0) { }
+};
+
+template<typename TVertexValue, typename TEdgeWeight>
+void ContractionHierarchy<TVertexValue, TEdgeWeight>::QueryContext::reset(int num_vertices)
+{
+	for(int side=0; side < 2; ++side)
+	{
+		if(static_cast<size_t>(num_vertices) > sides[side].costs.size())
+		{
+			sides[side].costs.resize(num_vertices);
+			sides[side].parents.resize(num_vertices);
+			sides[side].generations.resize(num_vertices, 0);
+			sides[side].queue.resize(num_vertices);
+		}
+		sides[side].queue.clear();
+	}
+
+	++generation;
+	if(generation == 0)
+	{
+		for(int side=0; side < 2; ++side)
+			std::fill(sides[side].generations.begin(), sides[side].generations.end(), 0);
+		generation = 1;
+	}
+}
+
+//  :        
+//     (outgoing, destination -  )   (incoming, destination -  ) .
+template<typename TVertexValue, typename TEdgeWeight>
+class ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder
+{
+	//    ,    -.
+	//        , , ,   -     .
+	static const int WITNESS_SETTLE_LIMIT = 100;
+
+	std::vector<std::vector<Arc>> outgoing;
+	std::vector<std::vector<Arc>> incoming;
+	std::vector<bool> is_contracted;
+	std::vector<int> num_contracted_neighbors;
+
+	std::vector<TEdgeWeight> witness_costs;
+	std::vector<unsigned int> witness_generations;
+	unsigned int witness_generation;
+	IndexedPriorityQueue<TEdgeWeight> witness_queue;
+
+	void find_witnesses(const int source, const int excluded, const TEdgeWeight& max_cost);
+	bool has_witness(const int target, const TEdgeWeight& cost) const;
+	static void add_or_update_arc(std::vector<Arc>& arcs, const int destination, const TEdgeWeight& weight, const int middle);
+	static void remove_arc(std::vector<Arc>& arcs, const int destination);
+	void add_or_update_arc(const int vertex_origin, const int vertex_destination, const TEdgeWeight& weight, const int middle);
+public:
+	explicit Builder(const Graph<TVertexValue, TEdgeWeight>& graph);
+	int contract(const int vertex, const bool is_simulation);
+	int get_priority(const int vertex);
+	void finish_vertex(const int vertex, std::vector<Arc>& outgoing_arcs, std::vector<Arc>& incoming_arcs);
+};
+
+template<typename TVertexValue, typename TEdgeWeight>
+ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::Builder(const Graph<TVertexValue, TEdgeWeight>& graph)
+	: outgoing(graph.get_num_vertices()), incoming(graph.get_num_vertices()), is_contracted(graph.get_num_vertices(), false),
+	num_contracted_neighbors(graph.get_num_vertices(), 0),
+	witness_costs(graph.get_num_vertices()), witness_generations(graph.get_num_vertices(), 0),
+	witness_generation(0), witness_queue(graph.get_num_vertices())
+{
+	typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors;
+	for(int v=0; v < graph.get_num_vertices(); ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			if(neighbors.destination(i) != v)
+				add_or_update_arc(v, neighbors.destination(i), neighbors.weight(i), -1);
+	}
+}
+
+//          .
+template<typename TVertexValue, typename TEdgeWeight>
+void ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::add_or_update_arc(
+	std::vector<Arc>& arcs, const int destination, const TEdgeWeight& weight, const int middle)
+{
+	for(size_t i=0; i < arcs.size(); ++i)
+		if(arcs[i].destination == destination)
+		{
+			if(weight < arcs[i].weight)
+			{
+				arcs[i].weight = weight;
+				arcs[i].middle = middle;
+			}
+			return;
+		}
+	arcs.push_back(Arc(destination, weight, middle));
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+void ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::remove_arc(std::vector<Arc>& arcs, const int destination)
+{
+	for(size_t i=0; i < arcs.size(); ++i)
+		if(arcs[i].destination == destination)
+		{
+			arcs[i] = arcs.back();
+			arcs.pop_back();
+			return;
+		}
+}
+
+//   vertex_origin -> vertex_destination    .
+template<typename TVertexValue, typename TEdgeWeight>
+inline void ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::add_or_update_arc(
+	const int vertex_origin, const int vertex_destination, const TEdgeWeight& weight, const int middle)
+{
+	add_or_update_arc(outgoing[vertex_origin], vertex_destination, weight, middle);
+	add_or_update_arc(incoming[vertex_destination], vertex_origin, weight, middle);
+}
+
+//     source        excluded;
+//    max_cost.
+template<typename TVertexValue, typename TEdgeWeight>
+void ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::find_witnesses(
+	const int source, const int excluded, const TEdgeWeight& max_cost)
+{
+	++witness_generation;
+	if(witness_generation == 0)
+	{
+		std::fill(witness_generations.begin(), witness_generations.end(), 0);
+		witness_generation = 1;
+	}
+	witness_queue.clear();
+
+	witness_generations[source] = witness_generation;
+	witness_costs[source] = TEdgeWeight();
+	witness_queue.push(source, TEdgeWeight());
+
+	int num_settled = 0;
+	while(!witness_queue.empty() && num_settled < WITNESS_SETTLE_LIMIT)
+	{
+		int vertex = witness_queue.top();
+		TEdgeWeight cost = witness_queue.top_priority();
+		witness_queue.pop();
+		++num_settled;
+		if(max_cost < cost)
+			break;
+
+		const std::vector<Arc>& arcs = outgoing[vertex];
+		for(size_t i=0; i < arcs.size(); ++i)
+		{
+			int neighbor = arcs[i].destination;
+			if(neighbor == excluded || is_contracted[neighbor])
+				continue;
+			TEdgeWeight neighbor_cost = cost + arcs[i].weight;
+			if(max_cost < neighbor_cost)
+				continue;
+			if(witness_generations[neighbor] != witness_generation)
+			{
+				witness_generations[neighbor] = witness_generation;
+				witness_costs[neighbor] = neighbor_cost;
+				witness_queue.push(neighbor, neighbor_cost);
+			}
+			else if(neighbor_cost < witness_costs[neighbor] && witness_queue.contains(neighbor))
+			{
+				witness_costs[neighbor] = neighbor_cost;
+				witness_queue.decrease_key(neighbor, neighbor_cost);
+			}
+		}
+	}
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+bool ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::has_witness(const int target, const TEdgeWeight& cost) const
+{
+	return witness_generations[target] == witness_generation && !(cost < witness_costs[target]);
+}
+
+//  :     u -> vertex -> w      u -> w,
+//   u  w  -     vertex.
+//    (is_simulation)   ,     .
+template<typename TVertexValue, typename TEdgeWeight>
+int ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::contract(const int vertex, const bool is_simulation)
+{
+	std::vector<Arc> sources;
+	std::vector<Arc> targets;
+	for(size_t i=0; i < incoming[vertex].size(); ++i)
+		if(!is_contracted[incoming[vertex][i].destination])
+			sources.push_back(incoming[vertex][i]);
+	for(size_t i=0; i < outgoing[vertex].size(); ++i)
+		if(!is_contracted[outgoing[vertex][i].destination])
+			targets.push_back(outgoing[vertex][i]);
+
+	int num_added = 0;
+	for(size_t i=0; i < sources.size(); ++i)
+	{
+		bool has_targets = false;
+		TEdgeWeight max_cost = TEdgeWeight();
+		for(size_t j=0; j < targets.size(); ++j)
+		{
+			if(targets[j].destination == sources[i].destination)
+				continue;
+			TEdgeWeight cost = sources[i].weight + targets[j].weight;
+			if(!has_targets || max_cost < cost)
+				max_cost = cost;
+			has_targets = true;
+		}
+		if(!has_targets)
+			continue;
+
+		find_witnesses(sources[i].destination, vertex, max_cost);
+		for(size_t j=0; j < targets.size(); ++j)
+		{
+			if(targets[j].destination == sources[i].destination)
+				continue;
+			TEdgeWeight cost = sources[i].weight + targets[j].weight;
+			if(has_witness(targets[j].destination, cost))
+				continue;
+			++num_added;
+			if(!is_simulation)
+				add_or_update_arc(sources[i].destination, targets[j].destination, cost, vertex);
+		}
+	}
+	return num_added;
+}
+
+//     :       
+//      (     ).
+//     ,        - .
+template<typename TVertexValue, typename TEdgeWeight>
+int ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::get_priority(const int vertex)
+{
+	int num_removed = 0;
+	for(size_t i=0; i < outgoing[vertex].size(); ++i)
+		if(!is_contracted[outgoing[vertex][i].destination])
+			++num_removed;
+	for(size_t i=0; i < incoming[vertex].size(); ++i)
+		if(!is_contracted[incoming[vertex][i].destination])
+			++num_removed;
+	return contract(vertex, true) - num_removed + num_contracted_neighbors[vertex];
+}
+
+//   ,         (   ) 
+//         .
+template<typename TVertexValue, typename TEdgeWeight>
+void ContractionHierarchy<TVertexValue, TEdgeWeight>::Builder::finish_vertex(
+	const int vertex, std::vector<Arc>& outgoing_arcs, std::vector<Arc>& incoming_arcs)
+{
+	outgoing_arcs.clear();
+	for(size_t i=0; i < outgoing[vertex].size(); ++i)
+	{
+		int neighbor = outgoing[vertex][i].destination;
+		if(is_contracted[neighbor])
+			continue;
+		outgoing_arcs.push_back(outgoing[vertex][i]);
+		++num_contracted_neighbors[neighbor];
+		remove_arc(incoming[neighbor], vertex);
+	}
+	incoming_arcs.clear();
+	for(size_t i=0; i < incoming[vertex].size(); ++i)
+	{
+		int neighbor = incoming[vertex][i].destination;
+		if(is_contracted[neighbor])
+			continue;
+		incoming_arcs.push_back(incoming[vertex][i]);
+		++num_contracted_neighbors[neighbor];
+		remove_arc(outgoing[neighbor], vertex);
+	}
+	is_contracted[vertex] = true;
+	std::vector<Arc>().swap(outgoing[vertex]);
+	std::vector<Arc>().swap(incoming[vertex]);
+}
+
+//  .    :    
+// ,            .
+template<typename TVertexValue, typename TEdgeWeight>
+ContractionHierarchy<TVertexValue, TEdgeWeight>::ContractionHierarchy(const Graph<TVertexValue, TEdgeWeight>& graph)
+	: ranks(graph.get_num_vertices(), -1), num_shortcuts(0), num_vertices(graph.get_num_vertices())
+{
+	Builder builder(graph);
+	IndexedPriorityQueue<int> order_queue(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+		order_queue.push(v, builder.get_priority(v));
+
+	std::vector<std::vector<Arc>> arcs_by_vertex[2];
+	arcs_by_vertex[0].resize(num_vertices);
+	arcs_by_vertex[1].resize(num_vertices);
+	int rank = 0;
+	while(!order_queue.empty())
+	{
+		int vertex = order_queue.top();
+		order_queue.pop();
+		int priority = builder.get_priority(vertex);
+		if(!order_queue.empty() && order_queue.top_priority() < priority)
+		{
+			order_queue.push(vertex, priority);
+			continue;
+		}
+
+		builder.contract(vertex, false);
+		builder.finish_vertex(vertex, arcs_by_vertex[0][vertex], arcs_by_vertex[1][vertex]);
+		ranks[vertex] = rank++;
+	}
+
+	for(int side=0; side < 2; ++side)
+	{
+		offsets[side].resize(num_vertices + 1);
+		offsets[side][0] = 0;
+		for(int v=0; v < num_vertices; ++v)
+			offsets[side][v+1] = offsets[side][v] + arcs_by_vertex[side][v].size();
+		upward_arcs[side].reserve(offsets[side][num_vertices]);
+		for(int v=0; v < num_vertices; ++v)
+		{
+			for(size_t i=0; i < arcs_by_vertex[side][v].size(); ++i)
+			{
+				upward_arcs[side].push_back(arcs_by_vertex[side][v][i]);
+				if(arcs_by_vertex[side][v][i].middle != -1)
+					++num_shortcuts;
+			}
+			std::vector<Arc>().swap(arcs_by_vertex[side][v]);
+		}
+	}
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+int ContractionHierarchy<TVertexValue, TEdgeWeight>::get_num_vertices() const
+{
+	return num_vertices;
+}
+
+//        -1   .
+template<typename TVertexValue, typename TEdgeWeight>
+int ContractionHierarchy<TVertexValue, TEdgeWeight>::get_rank(const int vertex) const
+{
+	if(vertex >= num_vertices || vertex < 0)
+		return -1;
+	return ranks[vertex];
+}
+
+//  -;         .
+template<typename TVertexValue, typename TEdgeWeight>
+size_t ContractionHierarchy<TVertexValue, TEdgeWeight>::get_num_shortcuts() const
+{
+	return num_shortcuts;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+bool ContractionHierarchy<TVertexValue, TEdgeWeight>::find_shortest_path(
+	const std::set<int>& start_group, const std::set<int>& goal_group,
+	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost) const
+{
+	QueryContext context;
+	return find_shortest_path(start_group, goal_group, context, shortest_path, shortest_path_cost);
+}
+
+//          ,   AStarSearch::find_shortest_path.
+//        ,  -     ,
+//         .
+//  ,           .
+//        .
+template<typename TVertexValue, typename TEdgeWeight>
+bool ContractionHierarchy<TVertexValue, TEdgeWeight>::find_shortest_path(
+	const std::set<int>& start_group, const std::set<int>& goal_group,
+	QueryContext& context, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost) const
+{
+	if(start_group.empty() || goal_group.empty())
+		return false;
+
+	context.reset(num_vertices);
+	const std::set<int>* groups[2] = { &start_group, &goal_group };
+	for(int side=0; side < 2; ++side)
+		for(std::set<int>::const_iterator i=groups[side]->begin(); i != groups[side]->end(); ++i)
+		{
+			int vertex = *i;
+			if(vertex >= num_vertices || vertex < 0)
+				return false;
+			typename QueryContext::Side& state = context.sides[side];
+			state.generations[vertex] = context.generation;
+			state.costs[vertex] = TEdgeWeight();
+			state.parents[vertex] = -1;
+			state.queue.push(vertex, TEdgeWeight());
+		}
+
+	bool is_found = false;
+	int meeting_vertex = -1;
+	int side = 0;
+	while(true)
+	{
+		bool is_side_active[2];
+		for(int s=0; s < 2; ++s)
+			is_side_active[s] = !context.sides[s].queue.empty() &&
+				(!is_found || context.sides[s].queue.top_priority() < shortest_path_cost);
+		if(!is_side_active[0] && !is_side_active[1])
+			break;
+		if(!is_side_active[side])
+			side = 1 - side;
+
+		typename QueryContext::Side& state = context.sides[side];
+		int vertex = state.queue.top();
+		TEdgeWeight cost = state.queue.top_priority();
+		state.queue.pop();
+
+		if(context.is_reached(1 - side, vertex))
+		{
+			TEdgeWeight path_cost = cost + context.sides[1 - side].costs[vertex];
+			if(!is_found || path_cost < shortest_path_cost)
+			{
+				is_found = true;
+				meeting_vertex = vertex;
+				shortest_path_cost = path_cost;
+			}
+		}
+
+		const std::vector<Arc>& arcs = upward_arcs[side];
+		for(size_t i=offsets[side][vertex]; i < offsets[side][vertex+1]; ++i)
+		{
+			int neighbor = arcs[i].destination;
+			TEdgeWeight neighbor_cost = cost + arcs[i].weight;
+			if(state.generations[neighbor] != context.generation)
+			{
+				state.generations[neighbor] = context.generation;
+				state.costs[neighbor] = neighbor_cost;
+				state.parents[neighbor] = vertex;
+				state.queue.push(neighbor, neighbor_cost);
+			}
+			else if(neighbor_cost < state.costs[neighbor] && state.queue.contains(neighbor))
+			{
+				state.costs[neighbor] = neighbor_cost;
+				state.parents[neighbor] = vertex;
+				state.queue.decrease_key(neighbor, neighbor_cost);
+			}
+		}
+		side = 1 - side;
+	}
+
+	if(!is_found)
+		return false;
+
+	//   :           ;   .
+	std::vector<int> upward_path;
+	for(int vertex=meeting_vertex; vertex != -1; vertex=context.sides[0].parents[vertex])
+		upward_path.push_back(vertex);
+	shortest_path.clear();
+	shortest_path.push_back(upward_path.back());
+	for(size_t i=upward_path.size()-1; i > 0; --i)
+		unpack_arc(upward_path[i], upward_path[i-1], shortest_path);
+	for(int vertex=meeting_vertex; context.sides[1].parents[vertex] != -1; vertex=context.sides[1].parents[vertex])
+		unpack_arc(vertex, context.sides[1].parents[vertex], shortest_path);
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+bool ContractionHierarchy<TVertexValue, TEdgeWeight>::find_distance_matrix(
+	const std::vector<int>& sources, const std::vector<int>& targets, DistanceMatrix<TEdgeWeight>& matrix) const
+{
+	ThreadPool pool;
+	return find_distance_matrix(sources, targets, pool, matrix);
+}
+
+//     <<  >> (bucket-based many-to-many).
+//     t     ,     v 
+//     (t, d(v,t)).      s     ,
+//      v   : d(s,t) -  d(s,v) + d(v,t).
+//       ,      
+// (sources.size() + targets.size())    .       pool.
+//  false,     .
+template<typename TVertexValue, typename TEdgeWeight>
+bool ContractionHierarchy<TVertexValue, TEdgeWeight>::find_distance_matrix(
+	const std::vector<int>& sources, const std::vector<int>& targets,
+	ThreadPool& pool, DistanceMatrix<TEdgeWeight>& matrix) const
+{
+	for(size_t i=0; i < sources.size(); ++i)
+		if(sources[i] >= num_vertices || sources[i] < 0)
+			return false;
+	for(size_t i=0; i < targets.size(); ++i)
+		if(targets[i] >= num_vertices || targets[i] < 0)
+			return false;
+
+	matrix.reset(static_cast<int>(sources.size()), static_cast<int>(targets.size()));
+	if(sources.empty() || targets.empty())
+		return true;
+
+	std::vector<QueryContext> contexts(pool.get_num_threads());
+	std::vector<std::vector<BucketEntry>> worker_entries(pool.get_num_threads());
+	pool.parallel_for(targets.size(), [&](size_t index, size_t worker)
+	{
+		QueryContext& context = contexts[worker];
+		search_upward(targets[index], 1, context);
+		for(size_t i=0; i < context.settled.size(); ++i)
+		{
+			BucketEntry entry;
+			entry.vertex = context.settled[i];
+			entry.target_index = static_cast<int>(index);
+			entry.cost = context.sides[0].costs[entry.vertex];
+			worker_entries[worker].push_back(entry);
+		}
+	});
+
+	//   ,   :   v  [bucket_offsets[v], bucket_offsets[v+1]).
+	std::vector<size_t> bucket_offsets(num_vertices + 1, 0);
+	for(size_t worker=0; worker < worker_entries.size(); ++worker)
+		for(size_t i=0; i < worker_entries[worker].size(); ++i)
+			++bucket_offsets[worker_entries[worker][i].vertex + 1];
+	for(int v=0; v < num_vertices; ++v)
+		bucket_offsets[v+1] += bucket_offsets[v];
+	std::vector<BucketEntry> buckets(bucket_offsets[num_vertices]);
+	std::vector<size_t> bucket_ends(bucket_offsets.begin(), bucket_offsets.end() - 1);
+	for(size_t worker=0; worker < worker_entries.size(); ++worker)
+	{
+		for(size_t i=0; i < worker_entries[worker].size(); ++i)
+			buckets[bucket_ends[worker_entries[worker][i].vertex]++] = worker_entries[worker][i];
+		std::vector<BucketEntry>().swap(worker_entries[worker]);
+	}
+
+	pool.parallel_for(sources.size(), [&](size_t index, size_t worker)
+	{
+		QueryContext& context = contexts[worker];
+		search_upward(sources[index], 0, context);
+		for(size_t i=0; i < context.settled.size(); ++i)
+		{
+			int vertex = context.settled[i];
+			TEdgeWeight cost = context.sides[0].costs[vertex];
+			for(size_t j=bucket_offsets[vertex]; j < bucket_offsets[vertex+1]; ++j)
+				matrix.update_cost(static_cast<int>(index), buckets[j].target_index, cost + buckets[j].cost);
+		}
+	});
+	return true;
+}
+
+//     source        :  (side = 0)
+//    source,  (side = 1) -  source.
+//    context.sides[0],     context.settled.
+template<typename TVertexValue, typename TEdgeWeight>
+void ContractionHierarchy<TVertexValue, TEdgeWeight>::search_upward(const int source, const int side, QueryContext& context) const
+{
+	context.reset(num_vertices);
+	context.settled.clear();
+	typename QueryContext::Side& state = context.sides[0];
+	state.generations[source] = context.generation;
+	state.costs[source] = TEdgeWeight();
+	state.parents[source] = -1;
+	state.queue.push(source, TEdgeWeight());
+
+	while(!state.queue.empty())
+	{
+		int vertex = state.queue.top();
+		TEdgeWeight cost = state.queue.top_priority();
+		state.queue.pop();
+		context.settled.push_back(vertex);
+
+		const std::vector<Arc>& arcs = upward_arcs[side];
+		for(size_t i=offsets[side][vertex]; i < offsets[side][vertex+1]; ++i)
+		{
+			int neighbor = arcs[i].destination;
+			TEdgeWeight neighbor_cost = cost + arcs[i].weight;
+			if(state.generations[neighbor] != context.generation)
+			{
+				state.generations[neighbor] = context.generation;
+				state.costs[neighbor] = neighbor_cost;
+				state.parents[neighbor] = vertex;
+				state.queue.push(neighbor, neighbor_cost);
+			}
+			else if(neighbor_cost < state.costs[neighbor] && state.queue.contains(neighbor))
+			{
+				state.costs[neighbor] = neighbor_cost;
+				state.parents[neighbor] = vertex;
+				state.queue.decrease_key(neighbor, neighbor_cost);
+			}
+		}
+	}
+}
+
+//    vertex_origin -> vertex_destination;       
+//    ,    ,    ,  .
+template<typename TVertexValue, typename TEdgeWeight>
+const typename ContractionHierarchy<TVertexValue, TEdgeWeight>::Arc*
+	ContractionHierarchy<TVertexValue, TEdgeWeight>::find_arc(const int vertex_origin, const int vertex_destination) const
+{
+	int side = ranks[vertex_origin] < ranks[vertex_destination] ? 0 : 1;
+	int lower = side == 0 ? vertex_origin : vertex_destination;
+	int upper = side == 0 ? vertex_destination : vertex_origin;
+	for(size_t i=offsets[side][lower]; i < offsets[side][lower+1]; ++i)
+		if(upward_arcs[side][i].destination == upper)
+			return &upward_arcs[side][i];
+	return nullptr;
+}
+
+//   path    (vertex_origin, vertex_destination),  vertex_origin,
+//        .
+template<typename TVertexValue, typename TEdgeWeight>
+void ContractionHierarchy<TVertexValue, TEdgeWeight>::unpack_arc(
+	const int vertex_origin, const int vertex_destination, std::list<int>& path) const
+{
+	const Arc* arc = find_arc(vertex_origin, vertex_destination);
+	if(arc == nullptr || arc->middle == -1)
+	{
+		path.push_back(vertex_destination);
+		return;
+	}
+	unpack_arc(vertex_origin, arc->middle, path);
+	unpack_arc(arc->middle, vertex_destination, path);
+}
+#endif
@@ -0,0 +1,243 @@
+#pragma once
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "graph.h"
+
+template<typename TVertexValue, typename TEdgeWeight>
+class CSRGraph;
+
+//      :        .
+// reverse_weights -      nullptr,     ;
+//  reverse_weight        .
+template<typename TVertexValue, typename TEdgeWeight>
+class CSREdgeRange
+{
+	const CSRGraph<TVertexValue, TEdgeWeight>* graph;
+	int vertex;
+	const int* destinations;
+	const TEdgeWeight* weights;
+	const TEdgeWeight* reverse_weights;
+	size_t num_edges;
+public:
+	CSREdgeRange() : graph(nullptr), vertex(-1), destinations(nullptr), weights(nullptr), reverse_weights(nullptr),
+		num_edges(0) { }
+	CSREdgeRange(const CSRGraph<TVertexValue, TEdgeWeight>* graph, int vertex, const int* destinations,
+		const TEdgeWeight* weights, const TEdgeWeight* reverse_weights, size_t num_edges)
+		: graph(graph), vertex(vertex), destinations(destinations), weights(weights),
+		reverse_weights(reverse_weights), num_edges(num_edges) { }
+	size_t size() const { return num_edges; }
+	int destination(size_t i) const { return destinations[i]; }
+	TEdgeWeight weight(size_t i) const { return weights[i]; }
+	TEdgeWeight reverse_weight(size_t i) const;
+};
+
+//      CSR (compressed sparse row).
+//        destinations  weights,
+//   v   [offsets[v], offsets[v+1]).
+//    (     )    
+// ( ,  ALT).       (has_symmetric_weights),
+//      weights.   reverse_weights,  weights, 
+//    (store_reverse_weights),         .
+//    Graph             ,
+//       ,     .
+//     Graph,       AStarSearch  .
+//       ;       ,
+//        (. GraphBinaryIO),    storage  .
+template<typename TVertexValue, typename TEdgeWeight>
+class CSRGraph
+{
+	struct Arrays
+	{
+		std::vector<std::uint64_t> offsets;
+		std::vector<int> destinations;
+		std::vector<TEdgeWeight> weights;
+		std::vector<TEdgeWeight> reverse_weights;
+		std::vector<TVertexValue> values;
+	};
+
+	std::shared_ptr<const void> storage;
+	const std::uint64_t* offsets;
+	const int* destinations;
+	const TEdgeWeight* weights;
+	const TEdgeWeight* reverse_weights;
+	const TVertexValue* values;
+	int num_vertices;
+	bool is_symmetric;
+	std::uint64_t version;
+
+public:
+	typedef CSREdgeRange<TVertexValue, TEdgeWeight> NeighborRange;
+
+	explicit CSRGraph(const Graph<TVertexValue, TEdgeWeight>& graph, bool store_reverse_weights = false);
+	CSRGraph(const std::shared_ptr<const void>& storage, int num_vertices, const std::uint64_t* offsets,
+		const int* destinations, const TEdgeWeight* weights, const TEdgeWeight* reverse_weights,
+		const TVertexValue* values, bool is_symmetric);
+	int get_num_vertices() const;
+	size_t get_num_edges() const;
+	//  ,          (. Graph::get_version).
+	std::uint64_t get_version() const { return version; }
+	bool get_neighbor_range(const int vertex, NeighborRange& neighbors) const;
+	bool contains_edge(const int vertex_origin, const int vertex_destination) const;
+	bool get_edge_weight(const int vertex_origin, const int vertex_destination, TEdgeWeight& weight) const;
+	bool get_vertex_value(const int vertex, TVertexValue& value) const;
+	void print(std::ostream& out_stream) const;
+	const std::uint64_t* get_offsets() const { return offsets; }
+	const int* get_destinations() const { return destinations; }
+	const TEdgeWeight* get_weights() const { return weights; }
+	// nullptr,       .
+	const TEdgeWeight* get_reverse_weights() const { return reverse_weights; }
+	//     ,  , .
+	bool has_symmetric_weights() const { return is_symmetric; }
+	const TVertexValue* get_values() const { return values; }
+};
+
+//       :       ,
+//   .    ,   store_reverse_weights
+//    .     :      .
+template<typename TVertexValue, typename TEdgeWeight>
+CSRGraph<TVertexValue, TEdgeWeight>::CSRGraph(const Graph<TVertexValue, TEdgeWeight>& graph, bool store_reverse_weights)
+	: num_vertices(graph.get_num_vertices()), is_symmetric(true), version(get_next_graph_version())
+{
+	std::shared_ptr<Arrays> arrays = std::make_shared<Arrays>();
+	typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors;
+
+	arrays->offsets.resize(num_vertices + 1);
+	arrays->offsets[0] = 0;
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		arrays->offsets[v+1] = arrays->offsets[v] + neighbors.size();
+		for(size_t i=0; i < neighbors.size() && is_symmetric; ++i)
+			is_symmetric = neighbors.destination(i) == v || neighbors.weight(i) == neighbors.reverse_weight(i);
+	}
+
+	arrays->destinations.resize(static_cast<size_t>(arrays->offsets[num_vertices]));
+	arrays->weights.resize(static_cast<size_t>(arrays->offsets[num_vertices]));
+	if(store_reverse_weights && !is_symmetric)
+		arrays->reverse_weights.resize(static_cast<size_t>(arrays->offsets[num_vertices]));
+	arrays->values.resize(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			arrays->destinations[static_cast<size_t>(arrays->offsets[v]) + i] = neighbors.destination(i);
+			arrays->weights[static_cast<size_t>(arrays->offsets[v]) + i] = neighbors.weight(i);
+			if(!arrays->reverse_weights.empty())
+				arrays->reverse_weights[static_cast<size_t>(arrays->offsets[v]) + i] = neighbors.reverse_weight(i);
+		}
+		graph.get_vertex_value(v, arrays->values[v]);
+	}
+
+	offsets = &arrays->offsets[0];
+	destinations = arrays->destinations.empty() ? nullptr : &arrays->destinations[0];
+	weights = arrays->weights.empty() ? nullptr : &arrays->weights[0];
+	reverse_weights = arrays->reverse_weights.empty() ? nullptr : &arrays->reverse_weights[0];
+	values = arrays->values.empty() ? nullptr : &arrays->values[0];
+	storage = arrays;
+}
+
+//     ,   ; storage    .
+// reverse_weights   nullptr; is_symmetric -    ,  , .
+template<typename TVertexValue, typename TEdgeWeight>
+CSRGraph<TVertexValue, TEdgeWeight>::CSRGraph(const std::shared_ptr<const void>& storage, int num_vertices,
+	const std::uint64_t* offsets, const int* destinations, const TEdgeWeight* weights,
+	const TEdgeWeight* reverse_weights, const TVertexValue* values, bool is_symmetric)
+	: storage(storage), offsets(offsets), destinations(destinations), weights(weights),
+	reverse_weights(reverse_weights), values(values),
+	num_vertices(num_vertices), is_symmetric(is_symmetric), version(get_next_graph_version())
+{
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+inline TEdgeWeight CSREdgeRange<TVertexValue, TEdgeWeight>::reverse_weight(size_t i) const
+{
+	if(reverse_weights != nullptr)
+		return reverse_weights[i];
+	TEdgeWeight weight = weights[i];
+	graph->get_edge_weight(destinations[i], vertex, weight);
+	return weight;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+int CSRGraph<TVertexValue, TEdgeWeight>::get_num_vertices() const
+{
+	return num_vertices;
+}
+
+//      ;     .
+template<typename TVertexValue, typename TEdgeWeight>
+size_t CSRGraph<TVertexValue, TEdgeWeight>::get_num_edges() const
+{
+	return static_cast<size_t>(offsets[num_vertices]);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+bool CSRGraph<TVertexValue, TEdgeWeight>::get_neighbor_range(
+	const int vertex, NeighborRange& neighbors) const
+{
+	if(vertex >= num_vertices || vertex < 0)
+		return false;
+	size_t first = static_cast<size_t>(offsets[vertex]);
+	size_t count = static_cast<size_t>(offsets[vertex+1] - offsets[vertex]);
+	//           .
+	const TEdgeWeight* range_reverse_weights = reverse_weights != nullptr ? reverse_weights + first :
+		is_symmetric ? weights + first : nullptr;
+	neighbors = count == 0 ? NeighborRange() : NeighborRange(this, vertex, destinations + first, weights + first,
+		range_reverse_weights, count);
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+bool CSRGraph<TVertexValue, TEdgeWeight>::contains_edge(
+	const int vertex_origin, const int vertex_destination) const
+{
+	TEdgeWeight weight;
+	return get_edge_weight(vertex_origin, vertex_destination, weight);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+bool CSRGraph<TVertexValue, TEdgeWeight>::get_edge_weight(
+	const int vertex_origin, const int vertex_destination, TEdgeWeight& weight) const
+{
+	if(vertex_origin >= num_vertices || vertex_destination >= num_vertices
+		|| vertex_origin < 0 || vertex_destination < 0)
+		return false;
+
+	for(size_t i=static_cast<size_t>(offsets[vertex_origin]); i < offsets[vertex_origin+1]; ++i)
+		if(destinations[i] == vertex_destination)
+		{
+			weight = weights[i];
+			return true;
+		}
+
+	return false;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+bool CSRGraph<TVertexValue, TEdgeWeight>::get_vertex_value(
+	const int vertex, TVertexValue& value) const
+{
+	if(vertex >= num_vertices || vertex < 0)
+		return false;
+	value = values[vertex];
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+inline void CSRGraph<TVertexValue, TEdgeWeight>::print(std::ostream& out_stream) const
+{
+	for(int i=0; i < num_vertices; ++i)
+	{
+		out_stream << i << " <--> ";
+		for(size_t j=static_cast<size_t>(offsets[i]); j < offsets[i+1]; ++j)
+			out_stream << destinations[j] << " ";
+		out_stream << std::endl;
+	}
+}
+#endif
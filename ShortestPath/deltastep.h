@@ -0,0 +1,329 @@
+#pragma once
+#ifndef DELTASTEP_H
+#define DELTASTEP_H
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "threadpool.h"
+
+//   delta-stepping (Meyer, Sanders)     
+//        .
+//      delta    :   i 
+//     [i*delta, (i+1)*delta).     ,   
+//   -    .     (   delta)  :
+//         ,   ,  
+//  ;             ,
+//   .  delta,    ,   
+//      ,    delta -   - .
+//  ;      ,  .
+//       Graph,      CSRGraph.
+template<typename TVertexValue, typename TEdgeWeight>
+class DeltaStepping
+{
+public:
+	template<typename TGraph>
+	static bool find_shortest_path_tree(
+		const TGraph& graph, const std::set<int>& start_group,
+		std::vector<TEdgeWeight>& distances, std::vector<int>& parents);
+	template<typename TGraph>
+	static bool find_shortest_path_tree(
+		const TGraph& graph, const std::set<int>& start_group, ThreadPool& pool,
+		std::vector<TEdgeWeight>& distances, std::vector<int>& parents);
+	template<typename TGraph>
+	static bool find_shortest_path_tree(
+		const TGraph& graph, const std::set<int>& start_group, const TEdgeWeight& delta, ThreadPool& pool,
+		std::vector<TEdgeWeight>& distances, std::vector<int>& parents);
+	template<typename TGraph>
+	static TEdgeWeight get_default_delta(const TGraph& graph, ThreadPool& pool);
+	static TEdgeWeight unreachable() { return std::numeric_limits<TEdgeWeight>::max(); }
+private:
+	//  ,      ;  v   v % NUM_LOCKS.
+	static const int NUM_LOCKS = 4096;
+	// ,    ,    :      .
+	static const size_t MIN_PARALLEL_VERTICES = 1024;
+	//   max_weight/delta,      (. get_bucket_width).
+	static const size_t MAX_BUCKETS = 16384;
+
+	struct BucketEntry;
+	class State;
+	template<typename TGraph>
+	static TEdgeWeight get_max_weight(const TGraph& graph, ThreadPool& pool);
+	static TEdgeWeight get_bucket_width(const TEdgeWeight& delta, const TEdgeWeight& max_weight);
+	template<typename TBody>
+	static void for_each(ThreadPool& pool, const size_t count, const TBody& body);
+	template<typename TGraph>
+	static void relax_edges(const TGraph& graph, const BucketEntry& entry, const bool is_light, State& state,
+		const size_t worker);
+};
+
+//      ,     .    ,
+//     ,       ( ).
+template<typename TVertexValue, typename TEdgeWeight>
+struct DeltaStepping<TVertexValue, TEdgeWeight>::BucketEntry
+{
+	int vertex;
+	TEdgeWeight distance;
+
+	BucketEntry(int vertex, const TEdgeWeight& distance) : vertex(vertex), distance(distance) {}
+};
+
+//   .  :    ,  
+//  ,           .
+//       ,       .
+//    :    i     i + max_weight/delta.
+template<typename TVertexValue, typename TEdgeWeight>
+class DeltaStepping<TVertexValue, TEdgeWeight>::State
+{
+public:
+	std::vector<std::atomic<TEdgeWeight>> distances;
+	std::vector<int> parents;
+	std::vector<std::mutex> locks;
+	std::vector<std::vector<std::vector<BucketEntry>>> worker_buckets;
+	TEdgeWeight delta;
+	size_t num_buckets;
+
+	State(int num_vertices, size_t num_workers, const TEdgeWeight& delta, const TEdgeWeight& max_weight);
+	size_t get_bucket(const TEdgeWeight& distance) const;
+	void relax(const int origin, const int destination, const TEdgeWeight& distance, const size_t worker);
+};
+
+template<typename TVertexValue, typename TEdgeWeight>
+DeltaStepping<TVertexValue, TEdgeWeight>::State::State(int num_vertices, size_t num_workers,
+	const TEdgeWeight& delta, const TEdgeWeight& max_weight)
+	: distances(num_vertices), parents(num_vertices, -1), locks(NUM_LOCKS), worker_buckets(num_workers),
+	delta(delta), num_buckets(static_cast<size_t>(max_weight/delta) + 2)
+{
+	for(int v=0; v < num_vertices; ++v)
+		distances[v].store(unreachable(), std::memory_order_relaxed);
+	for(size_t i=0; i < num_workers; ++i)
+		worker_buckets[i].resize(num_buckets);
+}
+
+//    .
+template<typename TVertexValue, typename TEdgeWeight>
+inline size_t DeltaStepping<TVertexValue, TEdgeWeight>::State::get_bucket(const TEdgeWeight& distance) const
+{
+	return static_cast<size_t>(distance/delta) % num_buckets;
+}
+
+//    destination,    origin ,       worker.
+template<typename TVertexValue, typename TEdgeWeight>
+inline void DeltaStepping<TVertexValue, TEdgeWeight>::State::relax(const int origin, const int destination,
+	const TEdgeWeight& distance, const size_t worker)
+{
+	if(!(distance < distances[destination].load(std::memory_order_relaxed)))
+		return;
+	{
+		std::lock_guard<std::mutex> lock(locks[destination % NUM_LOCKS]);
+		if(!(distance < distances[destination].load(std::memory_order_relaxed)))
+			return;
+		distances[destination].store(distance, std::memory_order_relaxed);
+		parents[destination] = origin;
+	}
+	worker_buckets[worker][get_bucket(distance)].push_back(BucketEntry(destination, distance));
+}
+
+//           delta   (get_default_delta).
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+bool DeltaStepping<TVertexValue, TEdgeWeight>::find_shortest_path_tree(
+	const TGraph& graph, const std::set<int>& start_group,
+	std::vector<TEdgeWeight>& distances, std::vector<int>& parents)
+{
+	ThreadPool pool;
+	return find_shortest_path_tree(graph, start_group, pool, distances, parents);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+bool DeltaStepping<TVertexValue, TEdgeWeight>::find_shortest_path_tree(
+	const TGraph& graph, const std::set<int>& start_group, ThreadPool& pool,
+	std::vector<TEdgeWeight>& distances, std::vector<int>& parents)
+{
+	return find_shortest_path_tree(graph, start_group, get_default_delta(graph, pool), pool, distances, parents);
+}
+
+//  distances  parents    .     TEdgeWeight()
+//   -1,  <<>>   AStarSearch::find_shortest_path;   
+//   parents   .     unreachable()
+//   -1.  false,   ,       delta  .
+//   delta   max_weight/MAX_BUCKETS (. get_bucket_width).
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+bool DeltaStepping<TVertexValue, TEdgeWeight>::find_shortest_path_tree(
+	const TGraph& graph, const std::set<int>& start_group, const TEdgeWeight& delta, ThreadPool& pool,
+	std::vector<TEdgeWeight>& distances, std::vector<int>& parents)
+{
+	const int num_vertices = graph.get_num_vertices();
+	if(start_group.empty() || !(TEdgeWeight() < delta))
+		return false;
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+		if(*i >= num_vertices || *i < 0)
+			return false;
+
+	TEdgeWeight max_weight = get_max_weight(graph, pool);
+	State state(num_vertices, pool.get_num_threads(), get_bucket_width(delta, max_weight), max_weight);
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+	{
+		state.distances[*i].store(TEdgeWeight(), std::memory_order_relaxed);
+		state.worker_buckets[0][0].push_back(BucketEntry(*i, TEdgeWeight()));
+	}
+
+	std::vector<BucketEntry> frontier;
+	std::vector<BucketEntry> removed;
+	size_t current = 0;
+	while(true)
+	{
+		//   : ,    ,    .
+		removed.clear();
+		while(true)
+		{
+			frontier.clear();
+			for(size_t worker=0; worker < state.worker_buckets.size(); ++worker)
+			{
+				std::vector<BucketEntry>& bucket = state.worker_buckets[worker][current];
+				for(size_t i=0; i < bucket.size(); ++i)
+					if(!(state.distances[bucket[i].vertex].load(std::memory_order_relaxed) < bucket[i].distance))
+						frontier.push_back(bucket[i]);
+				bucket.clear();
+			}
+			if(frontier.empty())
+				break;
+			removed.insert(removed.end(), frontier.begin(), frontier.end());
+			for_each(pool, frontier.size(), [&](size_t index, size_t worker)
+			{
+				relax_edges(graph, frontier[index], true, state, worker);
+			});
+		}
+
+		//          .
+		for_each(pool, removed.size(), [&](size_t index, size_t worker)
+		{
+			if(!(state.distances[removed[index].vertex].load(std::memory_order_relaxed) < removed[index].distance))
+				relax_edges(graph, removed[index], false, state, worker);
+		});
+
+		size_t next = 1;
+		for(; next < state.num_buckets; ++next)
+		{
+			size_t bucket = (current + next) % state.num_buckets;
+			bool is_empty = true;
+			for(size_t worker=0; worker < state.worker_buckets.size() && is_empty; ++worker)
+				is_empty = state.worker_buckets[worker][bucket].empty();
+			if(!is_empty)
+				break;
+		}
+		if(next == state.num_buckets)
+			break;
+		current = (current + next) % state.num_buckets;
+	}
+
+	distances.resize(num_vertices);
+	for_each(pool, static_cast<size_t>(num_vertices), [&](size_t index, size_t)
+	{
+		distances[index] = state.distances[index].load(std::memory_order_relaxed);
+	});
+	parents.swap(state.parents);
+	return true;
+}
+
+//   (is_light)      .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+inline void DeltaStepping<TVertexValue, TEdgeWeight>::relax_edges(const TGraph& graph, const BucketEntry& entry,
+	const bool is_light, State& state, const size_t worker)
+{
+	typename TGraph::NeighborRange neighbors;
+	graph.get_neighbor_range(entry.vertex, neighbors);
+	for(size_t i=0; i < neighbors.size(); ++i)
+		if(state.delta < neighbors.weight(i) ? !is_light : is_light)
+			state.relax(entry.vertex, neighbors.destination(i), entry.distance + neighbors.weight(i), worker);
+}
+
+//     - max_weight/average_degree (      ),
+//      :          .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+TEdgeWeight DeltaStepping<TVertexValue, TEdgeWeight>::get_default_delta(const TGraph& graph, ThreadPool& pool)
+{
+	const int num_vertices = graph.get_num_vertices();
+	std::vector<double> weight_sums(pool.get_num_threads(), 0.0);
+	std::vector<size_t> num_edges(pool.get_num_threads(), 0);
+	std::vector<TEdgeWeight> max_weights(pool.get_num_threads(), TEdgeWeight());
+	for_each(pool, static_cast<size_t>(num_vertices), [&](size_t index, size_t worker)
+	{
+		typename TGraph::NeighborRange neighbors;
+		graph.get_neighbor_range(static_cast<int>(index), neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			weight_sums[worker] += static_cast<double>(neighbors.weight(i));
+			max_weights[worker] = std::max(max_weights[worker], neighbors.weight(i));
+		}
+		num_edges[worker] += neighbors.size();
+	});
+
+	double weight_sum = 0.0;
+	size_t total_edges = 0;
+	TEdgeWeight max_weight = TEdgeWeight();
+	for(size_t i=0; i < weight_sums.size(); ++i)
+	{
+		weight_sum += weight_sums[i];
+		total_edges += num_edges[i];
+		max_weight = std::max(max_weight, max_weights[i]);
+	}
+	if(total_edges == 0)
+		return static_cast<TEdgeWeight>(1);
+	double average_degree = static_cast<double>(total_edges)/num_vertices;
+	TEdgeWeight delta = static_cast<TEdgeWeight>(
+		std::max(static_cast<double>(max_weight)/average_degree, weight_sum/total_edges));
+	//    delta    .
+	return TEdgeWeight() < delta ? delta : static_cast<TEdgeWeight>(1);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+TEdgeWeight DeltaStepping<TVertexValue, TEdgeWeight>::get_max_weight(const TGraph& graph, ThreadPool& pool)
+{
+	std::vector<TEdgeWeight> max_weights(pool.get_num_threads(), TEdgeWeight());
+	for_each(pool, static_cast<size_t>(graph.get_num_vertices()), [&](size_t index, size_t worker)
+	{
+		typename TGraph::NeighborRange neighbors;
+		graph.get_neighbor_range(static_cast<int>(index), neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			max_weights[worker] = std::max(max_weights[worker], neighbors.weight(i));
+	});
+	return *std::max_element(max_weights.begin(), max_weights.end());
+}
+
+//  : delta,    max_weight/MAX_BUCKETS.  max_weight/delta + 2,     delta
+//      ,            size_t.
+//      -      , -  
+//  .      ,      2*MAX_BUCKETS + 2.
+template<typename TVertexValue, typename TEdgeWeight>
+TEdgeWeight DeltaStepping<TVertexValue, TEdgeWeight>::get_bucket_width(const TEdgeWeight& delta, const TEdgeWeight& max_weight)
+{
+	const TEdgeWeight max_buckets = static_cast<TEdgeWeight>(MAX_BUCKETS);
+	if(!(max_buckets < max_weight/delta))
+		return delta;
+	return max_weight/max_buckets;
+}
+
+//  body(index, worker)   index  [0, count):   count -   
+//    0 (    ),  - parallel_for .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TBody>
+void DeltaStepping<TVertexValue, TEdgeWeight>::for_each(ThreadPool& pool, const size_t count, const TBody& body)
+{
+	if(count < MIN_PARALLEL_VERTICES)
+	{
+		for(size_t index=0; index < count; ++index)
+			body(index, 0);
+		return;
+	}
+	pool.parallel_for(count, body);
+}
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef DISTMATRIX_H
+#define DISTMATRIX_H
+
+#include <vector>
+
+//     :  -  ,  - .
+//     ,         (get_row()).
+//     is_found ,    TEdgeWeight().
+//   ,    std::vector<bool>,       .
+template<typename TEdgeWeight>
+class DistanceMatrix
+{
+	int num_sources;
+	int num_targets;
+	std::vector<TEdgeWeight> costs;
+	std::vector<unsigned char> found_flags;
+public:
+	DistanceMatrix() : num_sources(0), num_targets(0) { }
+	DistanceMatrix(int num_sources, int num_targets) { reset(num_sources, num_targets); }
+	void reset(int num_sources, int num_targets);
+	int get_num_sources() const { return num_sources; }
+	int get_num_targets() const { return num_targets; }
+	bool is_found(int source_index, int target_index) const;
+	bool get_cost(int source_index, int target_index, TEdgeWeight& cost) const;
+	void set_cost(int source_index, int target_index, const TEdgeWeight& cost);
+	bool update_cost(int source_index, int target_index, const TEdgeWeight& cost);
+	const TEdgeWeight* get_row(int source_index) const { return &costs[static_cast<size_t>(source_index)*num_targets]; }
+};
+
+//        .
+template<typename TEdgeWeight>
+void DistanceMatrix<TEdgeWeight>::reset(int num_sources, int num_targets)
+{
+	this->num_sources = num_sources;
+	this->num_targets = num_targets;
+	costs.assign(static_cast<size_t>(num_sources)*num_targets, TEdgeWeight());
+	found_flags.assign(costs.size(), 0);
+}
+
+template<typename TEdgeWeight>
+inline bool DistanceMatrix<TEdgeWeight>::is_found(int source_index, int target_index) const
+{
+	return found_flags[static_cast<size_t>(source_index)*num_targets + target_index] != 0;
+}
+
+//  false,      .
+template<typename TEdgeWeight>
+inline bool DistanceMatrix<TEdgeWeight>::get_cost(int source_index, int target_index, TEdgeWeight& cost) const
+{
+	size_t index = static_cast<size_t>(source_index)*num_targets + target_index;
+	if(!found_flags[index])
+		return false;
+	cost = costs[index];
+	return true;
+}
+
+template<typename TEdgeWeight>
+inline void DistanceMatrix<TEdgeWeight>::set_cost(int source_index, int target_index, const TEdgeWeight& cost)
+{
+	size_t index = static_cast<size_t>(source_index)*num_targets + target_index;
+	costs[index] = cost;
+	found_flags[index] = 1;
+}
+
+//  cost,       cost   ;  true  .
+template<typename TEdgeWeight>
+inline bool DistanceMatrix<TEdgeWeight>::update_cost(int source_index, int target_index, const TEdgeWeight& cost)
+{
+	size_t index = static_cast<size_t>(source_index)*num_targets + target_index;
+	if(found_flags[index] && !(cost < costs[index]))
+		return false;
+	costs[index] = cost;
+	found_flags[index] = 1;
+	return true;
+}
+#endif
@@ -0,0 +1,132 @@
+#pragma once
+#ifndef EDGEINDEX_H
+#define EDGEINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+//  : -      .
+//  -  ( ,  ),  -       .
+//      ;        
+//  ,  <<>>         .
+class EdgeIndex
+{
+	struct Slot
+	{
+		int origin;
+		int destination;
+		size_t position;
+	};
+
+	std::vector<Slot> slots;
+	size_t num_entries;
+	int capacity_bits;
+
+	size_t get_home(const int origin, const int destination) const;
+	size_t find_slot(const int origin, const int destination) const;
+	void grow();
+public:
+	EdgeIndex() : num_entries(0), capacity_bits(0) { }
+	size_t size() const { return num_entries; }
+	bool find(const int origin, const int destination, size_t& position) const;
+	bool insert(const int origin, const int destination, const size_t position);
+	void assign(const int origin, const int destination, const size_t position);
+	bool erase(const int origin, const int destination);
+};
+
+//  :       .
+inline size_t EdgeIndex::get_home(const int origin, const int destination) const
+{
+	std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(origin)) << 32) |
+		static_cast<std::uint32_t>(destination);
+	return static_cast<size_t>((key*0x9E3779B97F4A7C15ULL) >> (64 - capacity_bits));
+}
+
+//          ,   .
+inline size_t EdgeIndex::find_slot(const int origin, const int destination) const
+{
+	const size_t mask = slots.size() - 1;
+	size_t current = get_home(origin, destination);
+	while(slots[current].origin != -1 &&
+		(slots[current].origin != origin || slots[current].destination != destination))
+		current = (current + 1) & mask;
+	return current;
+}
+
+inline void EdgeIndex::grow()
+{
+	std::vector<Slot> old_slots;
+	old_slots.swap(slots);
+	capacity_bits = capacity_bits == 0 ? 4 : capacity_bits + 1;
+	Slot empty_slot = { -1, -1, 0 };
+	slots.assign(static_cast<size_t>(1) << capacity_bits, empty_slot);
+	for(size_t i=0; i < old_slots.size(); ++i)
+		if(old_slots[i].origin != -1)
+			slots[find_slot(old_slots[i].origin, old_slots[i].destination)] = old_slots[i];
+}
+
+inline bool EdgeIndex::find(const int origin, const int destination, size_t& position) const
+{
+	if(num_entries == 0)
+		return false;
+	const Slot& slot = slots[find_slot(origin, destination)];
+	if(slot.origin == -1)
+		return false;
+	position = slot.position;
+	return true;
+}
+
+//  ,       ;  true,   .
+inline bool EdgeIndex::insert(const int origin, const int destination, const size_t position)
+{
+	if(2*(num_entries + 1) > slots.size())
+		grow();
+	Slot& slot = slots[find_slot(origin, destination)];
+	if(slot.origin != -1)
+		return false;
+	slot.origin = origin;
+	slot.destination = destination;
+	slot.position = position;
+	++num_entries;
+	return true;
+}
+
+//       .
+inline void EdgeIndex::assign(const int origin, const int destination, const size_t position)
+{
+	if(2*(num_entries + 1) > slots.size())
+		grow();
+	Slot& slot = slots[find_slot(origin, destination)];
+	if(slot.origin == -1)
+	{
+		slot.origin = origin;
+		slot.destination = destination;
+		++num_entries;
+	}
+	slot.position = position;
+}
+
+inline bool EdgeIndex::erase(const int origin, const int destination)
+{
+	if(num_entries == 0)
+		return false;
+	const size_t mask = slots.size() - 1;
+	size_t hole = find_slot(origin, destination);
+	if(slots[hole].origin == -1)
+		return false;
+
+	//    current    ,           current.
+	for(size_t current=(hole + 1) & mask; slots[current].origin != -1; current=(current + 1) & mask)
+	{
+		size_t home = get_home(slots[current].origin, slots[current].destination);
+		if(((current - home) & mask) >= ((current - hole) & mask))
+		{
+			slots[hole] = slots[current];
+			hole = current;
+		}
+	}
+	slots[hole].origin = -1;
+	--num_entries;
+	return true;
+}
+#endif
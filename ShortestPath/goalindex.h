@@ -0,0 +1,161 @@
+#pragma once
+#ifndef GOALINDEX_H
+#define GOALINDEX_H
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <vector>
+#include "graphio.h"
+
+//  k-d     .
+//     :   [first, last)    ,
+//  -       ,  -  ;    .
+class PointKDTree
+{
+	std::vector<point> points;
+
+	void build(size_t first, size_t last, int axis);
+	void find_nearest(size_t first, size_t last, int axis, const point& query, double& min_squared_distance) const;
+public:
+	PointKDTree() { }
+	explicit PointKDTree(const std::vector<point>& points);
+	bool empty() const;
+	size_t size() const;
+	double get_min_squared_distance(const point& query) const;
+};
+
+inline PointKDTree::PointKDTree(const std::vector<point>& points) : points(points)
+{
+	build(0, this->points.size(), 0);
+}
+
+inline void PointKDTree::build(size_t first, size_t last, int axis)
+{
+	if(last - first <= 1)
+		return;
+	size_t middle = first + (last - first)/2;
+	std::nth_element(points.begin() + first, points.begin() + middle, points.begin() + last,
+		[axis](const point& lhs, const point& rhs) { return axis == 0 ? lhs.first < rhs.first : lhs.second < rhs.second; });
+	build(first, middle, 1 - axis);
+	build(middle + 1, last, 1 - axis);
+}
+
+inline bool PointKDTree::empty() const
+{
+	return points.empty();
+}
+
+inline size_t PointKDTree::size() const
+{
+	return points.size();
+}
+
+//   ,   ;   -  
+//       .
+inline void PointKDTree::find_nearest(size_t first, size_t last, int axis, const point& query, double& min_squared_distance) const
+{
+	if(first >= last)
+		return;
+	size_t middle = first + (last - first)/2;
+	double x = points[middle].first - query.first;
+	double y = points[middle].second - query.second;
+	double squared_distance = x*x + y*y;
+	if(squared_distance < min_squared_distance)
+		min_squared_distance = squared_distance;
+
+	double split_distance = axis == 0 ? query.first - points[middle].first : query.second - points[middle].second;
+	if(split_distance < 0)
+	{
+		find_nearest(first, middle, 1 - axis, query, min_squared_distance);
+		if(split_distance*split_distance < min_squared_distance)
+			find_nearest(middle + 1, last, 1 - axis, query, min_squared_distance);
+	}
+	else
+	{
+		find_nearest(middle + 1, last, 1 - axis, query, min_squared_distance);
+		if(split_distance*split_distance < min_squared_distance)
+			find_nearest(first, middle, 1 - axis, query, min_squared_distance);
+	}
+}
+
+//      ;    - .
+inline double PointKDTree::get_min_squared_distance(const point& query) const
+{
+	double min_squared_distance = std::numeric_limits<double>::infinity();
+	find_nearest(0, points.size(), 0, query, min_squared_distance);
+	return min_squared_distance;
+}
+
+//         .
+//        k-d ,     
+//            .
+//    ,   ,    .  , 
+// get_min_cost    (get_goal_group());  AStarSearch  JumpPointSearch  
+//              
+//   (. get_heuristic_group),          - ,
+//      .     (,  
+//   )    .
+//                 .
+class AStarEuclidianGoalSetHeuristic : public AStarEuclidianHeuristic
+{
+	std::set<int> goal_group;
+	PointKDTree goal_index;
+
+	template<typename TGraph>
+	double get_indexed_cost(const TGraph& graph, int start) const;
+public:
+	template<typename TGraph>
+	AStarEuclidianGoalSetHeuristic(const TGraph& graph, const std::set<int>& goal_group);
+	const std::set<int>& get_goal_group() const;
+	template<typename TGraph>
+	double get_min_cost(const TGraph& graph, int start, const std::set<int>& goal_group) const;
+	template<typename TGraph>
+	double get_min_reverse_cost(const TGraph& graph, int vertex, const std::set<int>& start_group) const;
+};
+
+template<typename TGraph>
+inline AStarEuclidianGoalSetHeuristic::AStarEuclidianGoalSetHeuristic(const TGraph& graph, const std::set<int>& goal_group)
+	: goal_group(goal_group)
+{
+	std::vector<point> goal_points;
+	goal_points.reserve(goal_group.size());
+	point goal_point;
+	for(std::set<int>::const_iterator i=goal_group.begin(); i != goal_group.end(); ++i)
+		if(graph.get_vertex_value(*i, goal_point))
+			goal_points.push_back(goal_point);
+	goal_index = PointKDTree(goal_points);
+}
+
+inline const std::set<int>& AStarEuclidianGoalSetHeuristic::get_goal_group() const
+{
+	return goal_group;
+}
+
+template<typename TGraph>
+inline double AStarEuclidianGoalSetHeuristic::get_indexed_cost(const TGraph& graph, int start) const
+{
+	point start_point;
+	graph.get_vertex_value(start, start_point);
+	return sqrt(goal_index.get_min_squared_distance(start_point));
+}
+
+//    ,     O(|goal_group|)   ;
+//         .
+template<typename TGraph>
+inline double AStarEuclidianGoalSetHeuristic::get_min_cost(
+	const TGraph& graph, int start, const std::set<int>& goal_group) const
+{
+	if(&goal_group == &this->goal_group)
+		return get_indexed_cost(graph, start);
+	return AStarEuclidianHeuristic::get_min_cost(graph, start, goal_group);
+}
+
+//   ,           .
+template<typename TGraph>
+inline double AStarEuclidianGoalSetHeuristic::get_min_reverse_cost(
+	const TGraph& graph, int vertex, const std::set<int>& start_group) const
+{
+	return get_min_cost(graph, vertex, start_group);
+}
+#endif
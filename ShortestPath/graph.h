@@ -2,8 +2,21 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <ostream>
+#include <utility>
 #include <vector>
+#include "edgeindex.h"
+
+//     .      ,   
+//      ,       (. ShortestPathCache).
+inline std::uint64_t get_next_graph_version()
+{
+	static std::atomic<std::uint64_t> last_version(0);
+	return ++last_version;
+}
 
 // ,   .
 //        .
@@ -15,39 +28,106 @@ struct Edge
 	Edge(int destination, TEdgeWeight weight): destination(destination), weight(weight)	{ }
 };
 
+//         (add_edges).
+template<typename TEdgeWeight>
+struct EdgeListEntry
+{
+	int origin;
+	int destination;
+	TEdgeWeight weight;
+	EdgeListEntry() : origin(-1), destination(-1), weight(TEdgeWeight()) { }
+	EdgeListEntry(int origin, int destination, TEdgeWeight weight): origin(origin), destination(destination), weight(weight) { }
+};
+
 // ,       (  ..).
+// is_indexed -       .
 template<typename TVertexValue, typename TEdgeWeight>
 struct Vertex
 {
 	TVertexValue value;
 	std::vector<Edge<TEdgeWeight>> neighbors;
-	Vertex() : value(TVertexValue()) { }
+	bool is_indexed;
+	Vertex() : value(TVertexValue()), is_indexed(false) { }
+};
+
+template<typename TVertexValue, typename TEdgeWeight>
+class Graph;
+
+//  ,   .
+//   ,      ,  
+//       (add_edge, remove_edge).
+// reverse_weight(i) -    destination(i) -> ,    
+// (. AStarSearch::find_shortest_path_bidirectional);    ,   get_edge_weight,
+//       -   .
+template<typename TVertexValue, typename TEdgeWeight>
+class EdgeRange
+{
+	const Graph<TVertexValue, TEdgeWeight>* graph;
+	int vertex;
+	const Edge<TEdgeWeight>* edges;
+	size_t num_edges;
+public:
+	EdgeRange() : graph(nullptr), vertex(-1), edges(nullptr), num_edges(0) { }
+	EdgeRange(const Graph<TVertexValue, TEdgeWeight>* graph, int vertex, const Edge<TEdgeWeight>* edges, size_t num_edges)
+		: graph(graph), vertex(vertex), edges(edges), num_edges(num_edges) { }
+	size_t size() const { return num_edges; }
+	int destination(size_t i) const { return edges[i].destination; }
+	TEdgeWeight weight(size_t i) const { return edges[i].weight; }
+	TEdgeWeight reverse_weight(size_t i) const;
 };
 
 //      .
 //      -   : /, 
 //   (    )       .
+//       (get_edge_weight, set_edge_weight, contains_edge, remove_edge  
+//   add_edge)         - (EdgeIndex),
+//     O(1)     .    
+//       -,       .
 template<typename TVertexValue, typename TEdgeWeight>
 class Graph
 {
+	// ,        .
+	static const size_t INDEXED_DEGREE = 16;
+
 	std::vector<Vertex<TVertexValue, TEdgeWeight>> adjacency_list;
 	int num_vertices;
+	EdgeIndex edge_index;
+	std::uint64_t version;
 	bool is_edge_valid(const int vertex_origin, const int vertex_destination) const;
+	bool find_edge(const int vertex_origin, const int vertex_destination, size_t& position) const;
+	void add_neighbor(const int vertex_origin, const int vertex_destination, const TEdgeWeight& weight);
+	void remove_neighbor(const int vertex_origin, const size_t position);
 
 public:
+	typedef EdgeRange<TVertexValue, TEdgeWeight> NeighborRange;
+
 	explicit Graph(int num_vertices);
 	bool add_edge(const int vertex_origin, const int vertex_destination, const TEdgeWeight& weight);
+	size_t add_edges(const std::vector<EdgeListEntry<TEdgeWeight>>& edges);
 	bool remove_edge(const int vertex_origin, const int vertex_destination);
 	int get_num_vertices() const;
+	//        (add_edge, add_edges, remove_edge, set_edge_weight,
+	// set_edge_weights);      .
+	std::uint64_t get_version() const { return version; }
 	bool get_neighbors(const int vertex, std::vector<Edge<TEdgeWeight>>& neighbors) const;
+	bool get_neighbor_range(const int vertex, NeighborRange& neighbors) const;
 	bool contains_edge(const int vertex_origin, const int vertex_destination) const;
 	bool get_edge_weight(const int vertex_origin, const int vertex_destination, TEdgeWeight& weight) const;
 	bool set_edge_weight(const int vertex_origin, const int vertex_destination, const TEdgeWeight& weight);
+	size_t set_edge_weights(const std::vector<EdgeListEntry<TEdgeWeight>>& edges);
 	bool get_vertex_value(const int vertex, TVertexValue& value) const;
 	bool set_vertex_value(const int vertex, const TVertexValue& value);
 	void print(std::ostream& out_stream) const;
 };
 
+template<typename TVertexValue, typename TEdgeWeight>
+inline TEdgeWeight EdgeRange<TVertexValue, TEdgeWeight>::reverse_weight(size_t i) const
+{
+	TEdgeWeight weight = edges[i].weight;
+	graph->get_edge_weight(edges[i].destination, vertex, weight);
+	return weight;
+}
+
 template<typename TVertexValue, typename TEdgeWeight>
 bool Graph<TVertexValue, TEdgeWeight>::is_edge_valid(
 	const int vertex_origin, const int vertex_destination) const
@@ -59,11 +139,79 @@ bool Graph<TVertexValue, TEdgeWeight>::is_edge_valid(
 }
 
 template<typename TVertexValue, typename TEdgeWeight>
-Graph<TVertexValue, TEdgeWeight>::Graph(int num_vertices) : num_vertices(num_vertices)
+Graph<TVertexValue, TEdgeWeight>::Graph(int num_vertices)
+	: num_vertices(num_vertices), version(get_next_graph_version())
 {
 	adjacency_list.resize(num_vertices);
 }
 
+//       :   ,    ,  .
+template<typename TVertexValue, typename TEdgeWeight>
+inline bool Graph<TVertexValue, TEdgeWeight>::find_edge(
+	const int vertex_origin, const int vertex_destination, size_t& position) const
+{
+	const Vertex<TVertexValue, TEdgeWeight>& vertex = adjacency_list[vertex_origin];
+	if(vertex.is_indexed)
+		return edge_index.find(vertex_origin, vertex_destination, position);
+	for(size_t i=0; i < vertex.neighbors.size(); ++i)
+		if(vertex.neighbors[i].destination == vertex_destination)
+		{
+			position = i;
+			return true;
+		}
+	return false;
+}
+
+//      ;     INDEXED_DEGREE,
+//      .         (  ),
+//      ,     .
+template<typename TVertexValue, typename TEdgeWeight>
+void Graph<TVertexValue, TEdgeWeight>::add_neighbor(
+	const int vertex_origin, const int vertex_destination, const TEdgeWeight& weight)
+{
+	Vertex<TVertexValue, TEdgeWeight>& vertex = adjacency_list[vertex_origin];
+	vertex.neighbors.push_back(Edge<TEdgeWeight>(vertex_destination, weight));
+	if(vertex.is_indexed)
+		edge_index.insert(vertex_origin, vertex_destination, vertex.neighbors.size() - 1);
+	else if(vertex.neighbors.size() >= INDEXED_DEGREE)
+	{
+		for(size_t i=0; i < vertex.neighbors.size(); ++i)
+			edge_index.insert(vertex_origin, vertex.neighbors[i].destination, i);
+		vertex.is_indexed = true;
+	}
+}
+
+//       O(1):       ,
+//        .       
+// (add_edge   ),   :    ,   
+//     ,          ,
+//       ,     .
+template<typename TVertexValue, typename TEdgeWeight>
+void Graph<TVertexValue, TEdgeWeight>::remove_neighbor(const int vertex_origin, const size_t position)
+{
+	Vertex<TVertexValue, TEdgeWeight>& vertex = adjacency_list[vertex_origin];
+	std::vector<Edge<TEdgeWeight>>& neighbors = vertex.neighbors;
+	if(vertex.is_indexed)
+		edge_index.erase(vertex_origin, neighbors[position].destination);
+	const size_t last = neighbors.size() - 1;
+	const bool is_loop_last = position + 1 < last && neighbors[last].destination == vertex_origin;
+	const size_t moved = is_loop_last ? last - 2 : last;
+	if(moved != position)
+	{
+		neighbors[position] = neighbors[moved];
+		if(vertex.is_indexed)
+			edge_index.assign(vertex_origin, neighbors[position].destination, position);
+	}
+	if(is_loop_last)
+	{
+		neighbors[last-2] = neighbors[last-1];
+		neighbors[last-1] = neighbors[last];
+		if(vertex.is_indexed)
+			edge_index.assign(vertex_origin, vertex_origin, last - 2);
+	}
+	neighbors.pop_back();
+}
+
 //  ,      
 //   : 1 2   2 1 .
 template<typename TVertexValue, typename TEdgeWeight>
@@ -73,15 +221,90 @@ bool Graph<TVertexValue, TEdgeWeight>::add_edge(
 	if(!is_edge_valid(vertex_origin, vertex_destination))
 		return false;
 
-	for(size_t i=0; i < adjacency_list[vertex_origin].neighbors.size(); ++i)
-		if(adjacency_list[vertex_origin].neighbors[i].destination == vertex_destination)
-			return false;
+	size_t position;
+	if(find_edge(vertex_origin, vertex_destination, position))
+		return false;
 
-	adjacency_list[vertex_origin].neighbors.push_back(Edge<TEdgeWeight>(vertex_destination, weight));
-	adjacency_list[vertex_destination].neighbors.push_back(Edge<TEdgeWeight>(vertex_origin, weight));
+	add_neighbor(vertex_origin, vertex_destination, weight);
+	add_neighbor(vertex_destination, vertex_origin, weight);
+	version = get_next_graph_version();
 	return true;
 }
 
+//       ,     add_edge   :
+//     (       ) ,   .
+//           ,     
+//  -  find_edge ( O(V + k log k)    k ,    ),
+//            .
+//    .
+template<typename TVertexValue, typename TEdgeWeight>
+size_t Graph<TVertexValue, TEdgeWeight>::add_edges(const std::vector<EdgeListEntry<TEdgeWeight>>& edges)
+{
+	//   -        .
+	struct EdgeKey
+	{
+		int lower;
+		int upper;
+		size_t order;
+		bool operator<(const EdgeKey& other) const
+		{
+			if(lower != other.lower)
+				return lower < other.lower;
+			if(upper != other.upper)
+				return upper < other.upper;
+			return order < other.order;
+		}
+	};
+
+	std::vector<EdgeKey> keys;
+	keys.reserve(edges.size());
+	for(size_t i=0; i < edges.size(); ++i)
+		if(is_edge_valid(edges[i].origin, edges[i].destination))
+		{
+			EdgeKey key = { std::min(edges[i].origin, edges[i].destination),
+				std::max(edges[i].origin, edges[i].destination), i };
+			keys.push_back(key);
+		}
+	std::sort(keys.begin(), keys.end());
+
+	//      ; ,    , .
+	std::vector<bool> is_added(edges.size(), false);
+	size_t num_added = 0;
+	for(size_t i=0; i < keys.size(); ++i)
+	{
+		size_t position;
+		if((i == 0 || keys[i].lower != keys[i-1].lower || keys[i].upper != keys[i-1].upper) &&
+			!find_edge(keys[i].lower, keys[i].upper, position))
+		{
+			is_added[keys[i].order] = true;
+			++num_added;
+		}
+	}
+	std::vector<EdgeKey>().swap(keys);
+
+	std::vector<size_t> degrees(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+		degrees[v] = adjacency_list[v].neighbors.size();
+	for(size_t i=0; i < edges.size(); ++i)
+		if(is_added[i])
+		{
+			++degrees[edges[i].origin];
+			++degrees[edges[i].destination];
+		}
+	for(int v=0; v < num_vertices; ++v)
+		adjacency_list[v].neighbors.reserve(degrees[v]);
+
+	for(size_t i=0; i < edges.size(); ++i)
+		if(is_added[i])
+		{
+			add_neighbor(edges[i].origin, edges[i].destination, edges[i].weight);
+			add_neighbor(edges[i].destination, edges[i].origin, edges[i].weight);
+		}
+	if(num_added != 0)
+		version = get_next_graph_version();
+	return num_added;
+}
+
 template<typename TVertexValue, typename TEdgeWeight>
 bool Graph<TVertexValue, TEdgeWeight>::remove_edge(
 	const int vertex_origin, const int vertex_destination)
@@ -89,22 +312,23 @@ bool Graph<TVertexValue, TEdgeWeight>::remove_edge(
 	if(!is_edge_valid(vertex_origin, vertex_destination))
 		return false;
 
-	for(size_t i=0; i < adjacency_list[vertex_origin].neighbors.size(); ++i)
-		if(adjacency_list[vertex_origin].neighbors[i].destination == vertex_destination)
-		{
-			adjacency_list[vertex_origin].neighbors.erase(
-				                             adjacency_list[vertex_origin].neighbors.begin()+i);
-			for(size_t j=0; j < adjacency_list[vertex_destination].neighbors.size(); ++j)
-				if(adjacency_list[vertex_destination].neighbors[j].destination == vertex_origin)
-				{
-					adjacency_list[vertex_destination].neighbors.erase(
-						                                  adjacency_list[vertex_destination].neighbors.begin()+j);
-					break;
-				}
-			return true;
-		}
-
-	return false;
+	size_t position;
+	if(!find_edge(vertex_origin, vertex_destination, position))
+		return false;
+	if(vertex_origin == vertex_destination)
+	{
+		//       ;   ,     .
+		remove_neighbor(vertex_origin, position + 1);
+		remove_neighbor(vertex_origin, position);
+	}
+	else
+	{
+		remove_neighbor(vertex_origin, position);
+		if(find_edge(vertex_destination, vertex_origin, position))
+			remove_neighbor(vertex_destination, position);
+	}
+	version = get_next_graph_version();
+	return true;
 }
 
 template<typename TVertexValue, typename TEdgeWeight>
@@ -117,6 +341,17 @@ bool Graph<TVertexValue, TEdgeWeight>::get_neighbors(
 	return true;
 }
 
+template<typename TVertexValue, typename TEdgeWeight>
+bool Graph<TVertexValue, TEdgeWeight>::get_neighbor_range(
+	const int vertex, NeighborRange& neighbors) const
+{
+	if(vertex >= num_vertices || vertex < 0)
+		return false;
+	const std::vector<Edge<TEdgeWeight>>& edges = adjacency_list[vertex].neighbors;
+	neighbors = NeighborRange(this, vertex, edges.empty() ? nullptr : &edges[0], edges.size());
+	return true;
+}
+
 template<typename TVertexValue, typename TEdgeWeight>
 int Graph<TVertexValue, TEdgeWeight>::get_num_vertices() const
 {
@@ -138,14 +373,11 @@ bool Graph<TVertexValue, TEdgeWeight>::get_edge_weight(
 	if(!is_edge_valid(vertex_origin, vertex_destination))
 		return false;
 
-	for(size_t i=0; i < adjacency_list[vertex_origin].neighbors.size(); ++i)
-		if (adjacency_list[vertex_origin].neighbors[i].destination == vertex_destination)
-		{
-			weight = adjacency_list[vertex_origin].neighbors[i].weight;
-			return true;
-		}
-
-	return false;
+	size_t position;
+	if(!find_edge(vertex_origin, vertex_destination, position))
+		return false;
+	weight = adjacency_list[vertex_origin].neighbors[position].weight;
+	return true;
 }
 
 template<typename TVertexValue, typename TEdgeWeight>
@@ -155,14 +387,49 @@ bool Graph<TVertexValue, TEdgeWeight>::set_edge_weight(
 	if(!is_edge_valid(vertex_origin, vertex_destination))
 		return false;
 
-	for(size_t i=0; i < adjacency_list[vertex_origin].neighbors.size(); ++i)
-		if (adjacency_list[vertex_origin].neighbors[i].destination == vertex_destination)
-		{
-			adjacency_list[vertex_origin].neighbors[i].weight = weight;
-			return true;
-		}
+	size_t position;
+	if(!find_edge(vertex_origin, vertex_destination, position))
+		return false;
+	adjacency_list[vertex_origin].neighbors[position].weight = weight;
+	version = get_next_graph_version();
+	return true;
+}
 
-	return false;
+//       ,   set_edge_weight      
+// (      ,   ),      .
+//     ,   ;     
+//  ,            .
+//    ;     .
+template<typename TVertexValue, typename TEdgeWeight>
+size_t Graph<TVertexValue, TEdgeWeight>::set_edge_weights(const std::vector<EdgeListEntry<TEdgeWeight>>& edges)
+{
+	std::vector<size_t> order(edges.size());
+	for(size_t i=0; i < edges.size(); ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&edges](size_t first, size_t second)
+	{
+		return edges[first].origin < edges[second].origin;
+	});
+
+	//  (  ,     )   .
+	std::vector<std::pair<size_t, size_t>> updates;
+	updates.reserve(edges.size());
+	for(size_t i=0; i < order.size(); ++i)
+	{
+		const EdgeListEntry<TEdgeWeight>& edge = edges[order[i]];
+		size_t position;
+		if(is_edge_valid(edge.origin, edge.destination) && find_edge(edge.origin, edge.destination, position))
+			updates.push_back(std::make_pair(order[i], position));
+	}
+
+	for(size_t i=0; i < updates.size(); ++i)
+	{
+		const EdgeListEntry<TEdgeWeight>& edge = edges[updates[i].first];
+		adjacency_list[edge.origin].neighbors[updates[i].second].weight = edge.weight;
+	}
+	if(!updates.empty())
+		version = get_next_graph_version();
+	return updates.size();
 }
 
 template<typename TVertexValue, typename TEdgeWeight>
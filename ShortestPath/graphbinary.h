@@ -0,0 +1,373 @@
+#pragma once
+#ifndef GRAPHBINARY_H
+#define GRAPHBINARY_H
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "csrgraph.h"
+#include "graphio.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//     CSRGraph.
+//       ,       8 
+// (  ):
+//
+// 	 SPGB, ,   ,  ,    , ,  
+// 		num_vertices+1  uint64:   v  [offsets[v], offsets[v+1])
+// 		num_edges  int -   
+// 			num_edges  TEdgeWeight
+//  	num_edges  TEdgeWeight -    (. CSRGraph);  ,
+//				  FLAG_REVERSE_WEIGHTS  
+// 		num_vertices  TVertexValue (, )
+//
+// FLAG_SYMMETRIC ,        (CSRGraph::has_symmetric_weights).
+//   - FNV-1a  64-  ,    .
+//        ,    CSRGraph  ,  map_file   ,
+//            :  
+//         ,    .
+//            TVertexValue  TEdgeWeight;
+//       (,    ..).
+class GraphBinaryIO
+{
+public:
+	static const std::uint32_t VERSION = 1;
+
+	template<typename TVertexValue, typename TEdgeWeight>
+	static void save(const CSRGraph<TVertexValue, TEdgeWeight>& graph, std::ostream& out_stream);
+	template<typename TVertexValue, typename TEdgeWeight>
+	static void save(const Graph<TVertexValue, TEdgeWeight>& graph, std::ostream& out_stream,
+		bool store_reverse_weights = false);
+	template<typename TVertexValue, typename TEdgeWeight>
+	static CSRGraph<TVertexValue, TEdgeWeight> map_file(const std::string& file_name, bool verify_checksum = true);
+	template<typename TVertexValue, typename TEdgeWeight>
+	static CSRGraph<TVertexValue, TEdgeWeight> from_stream(std::istream& in_stream, bool verify_checksum = true);
+
+private:
+	struct Header
+	{
+		char signature[4];
+		std::uint32_t version;
+		std::uint32_t byte_order;
+		std::uint32_t vertex_value_size;
+		std::uint32_t edge_weight_size;
+		std::uint32_t is_floating_weight;
+		std::int32_t num_vertices;
+		std::uint32_t flags;
+		std::uint64_t num_edges;
+		std::uint64_t checksum;
+	};
+
+	//    ,      .
+	struct Layout
+	{
+		std::uint64_t offsets;
+		std::uint64_t destinations;
+		std::uint64_t weights;
+		std::uint64_t reverse_weights;
+		std::uint64_t values;
+		std::uint64_t file_size;
+	};
+
+	class MappedFile;
+
+	static const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+	static const std::uint32_t FLAG_SYMMETRIC = 1;
+	static const std::uint32_t FLAG_REVERSE_WEIGHTS = 2;
+	static const std::uint64_t CHECKSUM_BASIS = 14695981039346656037ULL;
+	static const std::uint64_t CHECKSUM_PRIME = 1099511628211ULL;
+
+	static std::uint64_t align(std::uint64_t size) { return (size + 7) & ~static_cast<std::uint64_t>(7); }
+	template<typename TVertexValue, typename TEdgeWeight>
+	static Layout get_layout(std::int32_t num_vertices, std::uint64_t num_edges, bool has_reverse_weights);
+	template<typename TVertexValue, typename TEdgeWeight>
+	static void check_header(const Header& header, std::uint64_t file_size);
+	template<typename TVertexValue, typename TEdgeWeight>
+	static CSRGraph<TVertexValue, TEdgeWeight> from_memory(
+		const std::shared_ptr<const void>& storage, const char* data, std::uint64_t size, bool verify_checksum);
+	static std::uint64_t update_checksum(std::uint64_t checksum, const void* data, std::uint64_t size);
+	static void write_section(std::ostream& out_stream, const void* data, std::uint64_t size);
+};
+
+//       ;     .
+class GraphBinaryIO::MappedFile
+{
+	const void* address;
+	std::uint64_t size;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+	void close();
+public:
+	explicit MappedFile(const std::string& file_name);
+	~MappedFile();
+	const char* get_data() const { return static_cast<const char*>(address); }
+	std::uint64_t get_size() const { return size; }
+};
+
+#ifdef _WIN32
+inline GraphBinaryIO::MappedFile::MappedFile(const std::string& file_name)
+	: address(nullptr), size(0), file(INVALID_HANDLE_VALUE), mapping(nullptr)
+{
+	file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	LARGE_INTEGER file_size;
+	if(file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &file_size) ||
+		static_cast<std::uint64_t>(file_size.QuadPart) < sizeof(Header))
+	{
+		close();
+		throw std::ios_base::failure(IOEXCEPTION);
+	}
+	size = static_cast<std::uint64_t>(file_size.QuadPart);
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(mapping != nullptr)
+		address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if(address == nullptr)
+	{
+		close();
+		throw std::ios_base::failure(IOEXCEPTION);
+	}
+}
+
+inline GraphBinaryIO::MappedFile::~MappedFile()
+{
+	close();
+}
+
+inline void GraphBinaryIO::MappedFile::close()
+{
+	if(address != nullptr)
+		UnmapViewOfFile(address);
+	if(mapping != nullptr)
+		CloseHandle(mapping);
+	if(file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+	address = nullptr;
+	mapping = nullptr;
+	file = INVALID_HANDLE_VALUE;
+}
+#else
+//      :      .
+inline GraphBinaryIO::MappedFile::MappedFile(const std::string& file_name) : address(nullptr), size(0)
+{
+	int file = ::open(file_name.c_str(), O_RDONLY);
+	if(file == -1)
+		throw std::ios_base::failure(IOEXCEPTION);
+	struct stat file_status;
+	if(fstat(file, &file_status) != 0 || static_cast<std::uint64_t>(file_status.st_size) < sizeof(Header))
+	{
+		::close(file);
+		throw std::ios_base::failure(IOEXCEPTION);
+	}
+	size = static_cast<std::uint64_t>(file_status.st_size);
+	void* mapped = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, file, 0);
+	::close(file);
+	if(mapped == MAP_FAILED)
+		throw std::ios_base::failure(IOEXCEPTION);
+	address = mapped;
+}
+
+inline GraphBinaryIO::MappedFile::~MappedFile()
+{
+	close();
+}
+
+inline void GraphBinaryIO::MappedFile::close()
+{
+	if(address != nullptr)
+		munmap(const_cast<void*>(address), static_cast<size_t>(size));
+	address = nullptr;
+}
+#endif
+
+template<typename TVertexValue, typename TEdgeWeight>
+GraphBinaryIO::Layout GraphBinaryIO::get_layout(std::int32_t num_vertices, std::uint64_t num_edges,
+	bool has_reverse_weights)
+{
+	Layout layout;
+	layout.offsets = sizeof(Header);
+	layout.destinations = align(layout.offsets + (static_cast<std::uint64_t>(num_vertices) + 1)*sizeof(std::uint64_t));
+	layout.weights = align(layout.destinations + num_edges*sizeof(int));
+	layout.reverse_weights = align(layout.weights + num_edges*sizeof(TEdgeWeight));
+	layout.values = align(layout.reverse_weights + (has_reverse_weights ? num_edges*sizeof(TEdgeWeight) : 0));
+	layout.file_size = align(layout.values + static_cast<std::uint64_t>(num_vertices)*sizeof(TVertexValue));
+	return layout;
+}
+
+//  ,   8 ,   -  ,   .
+inline std::uint64_t GraphBinaryIO::update_checksum(std::uint64_t checksum, const void* data, std::uint64_t size)
+{
+	const char* bytes = static_cast<const char*>(data);
+	std::uint64_t word;
+	for(std::uint64_t i=0; i + sizeof(word) <= size; i += sizeof(word))
+	{
+		std::memcpy(&word, bytes + i, sizeof(word));
+		checksum = (checksum ^ word)*CHECKSUM_PRIME;
+	}
+	std::uint64_t tail = size % sizeof(word);
+	if(tail != 0)
+	{
+		word = 0;
+		std::memcpy(&word, bytes + size - tail, static_cast<size_t>(tail));
+		checksum = (checksum ^ word)*CHECKSUM_PRIME;
+	}
+	return checksum;
+}
+
+inline void GraphBinaryIO::write_section(std::ostream& out_stream, const void* data, std::uint64_t size)
+{
+	const char padding[8] = { 0 };
+	if(size != 0)
+		out_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+	out_stream.write(padding, static_cast<std::streamsize>(align(size) - size));
+}
+
+//   ;       .
+template<typename TVertexValue, typename TEdgeWeight>
+void GraphBinaryIO::save(const CSRGraph<TVertexValue, TEdgeWeight>& graph, std::ostream& out_stream)
+{
+	const std::uint64_t num_vertices = static_cast<std::uint64_t>(graph.get_num_vertices());
+	const std::uint64_t num_edges = graph.get_num_edges();
+	const bool has_reverse_weights = graph.get_reverse_weights() != nullptr;
+	const std::uint64_t sizes[5] = { (num_vertices + 1)*sizeof(std::uint64_t), num_edges*sizeof(int),
+		num_edges*sizeof(TEdgeWeight), has_reverse_weights ? num_edges*sizeof(TEdgeWeight) : 0,
+		num_vertices*sizeof(TVertexValue) };
+	const void* sections[5] = { graph.get_offsets(), graph.get_destinations(), graph.get_weights(),
+		graph.get_reverse_weights(), graph.get_values() };
+
+	Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.signature, "SPGB", sizeof(header.signature));
+	header.version = VERSION;
+	header.byte_order = BYTE_ORDER_MARK;
+	header.vertex_value_size = sizeof(TVertexValue);
+	header.edge_weight_size = sizeof(TEdgeWeight);
+	header.is_floating_weight = std::is_floating_point<TEdgeWeight>::value ? 1 : 0;
+	header.num_vertices = graph.get_num_vertices();
+	header.flags = (graph.has_symmetric_weights() ? FLAG_SYMMETRIC : 0) |
+		(has_reverse_weights ? FLAG_REVERSE_WEIGHTS : 0);
+	header.num_edges = num_edges;
+	header.checksum = CHECKSUM_BASIS;
+	for(int i=0; i < 5; ++i)
+		header.checksum = update_checksum(header.checksum, sections[i], sizes[i]);
+
+	out_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for(int i=0; i < 5; ++i)
+		write_section(out_stream, sections[i], sizes[i]);
+	if(!out_stream)
+		throw std::ios_base::failure(IOEXCEPTION);
+}
+
+//    ,   store_reverse_weights    .
+template<typename TVertexValue, typename TEdgeWeight>
+void GraphBinaryIO::save(const Graph<TVertexValue, TEdgeWeight>& graph, std::ostream& out_stream,
+	bool store_reverse_weights)
+{
+	save(CSRGraph<TVertexValue, TEdgeWeight>(graph, store_reverse_weights), out_stream);
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+void GraphBinaryIO::check_header(const Header& header, std::uint64_t file_size)
+{
+	if(std::memcmp(header.signature, "SPGB", sizeof(header.signature)) != 0 || header.version != VERSION ||
+		header.byte_order != BYTE_ORDER_MARK || header.vertex_value_size != sizeof(TVertexValue) ||
+		header.edge_weight_size != sizeof(TEdgeWeight) ||
+		header.is_floating_weight != (std::is_floating_point<TEdgeWeight>::value ? 1u : 0u) ||
+		(header.flags & ~(FLAG_SYMMETRIC | FLAG_REVERSE_WEIGHTS)) != 0 ||
+		header.num_vertices < 0 || header.num_edges > file_size/sizeof(int) ||
+		get_layout<TVertexValue, TEdgeWeight>(header.num_vertices, header.num_edges,
+			(header.flags & FLAG_REVERSE_WEIGHTS) != 0).file_size != file_size)
+		throw std::ios_base::failure(IOEXCEPTION);
+}
+
+//          ; storage   data.
+//  verify_checksum        ( O(V + E));
+//     O(1),         .
+template<typename TVertexValue, typename TEdgeWeight>
+CSRGraph<TVertexValue, TEdgeWeight> GraphBinaryIO::from_memory(
+	const std::shared_ptr<const void>& storage, const char* data, std::uint64_t size, bool verify_checksum)
+{
+	Header header;
+	if(size < sizeof(header))
+		throw std::ios_base::failure(IOEXCEPTION);
+	std::memcpy(&header, data, sizeof(header));
+	check_header<TVertexValue, TEdgeWeight>(header, size);
+
+	const bool has_reverse_weights = (header.flags & FLAG_REVERSE_WEIGHTS) != 0;
+	Layout layout = get_layout<TVertexValue, TEdgeWeight>(header.num_vertices, header.num_edges, has_reverse_weights);
+	const std::uint64_t* offsets = reinterpret_cast<const std::uint64_t*>(data + layout.offsets);
+	const int* destinations = reinterpret_cast<const int*>(data + layout.destinations);
+	if(offsets[0] != 0 || offsets[header.num_vertices] != header.num_edges)
+		throw std::ios_base::failure(IOEXCEPTION);
+
+	if(verify_checksum)
+	{
+		if(update_checksum(CHECKSUM_BASIS, data + sizeof(header), size - sizeof(header)) != header.checksum)
+			throw std::ios_base::failure(IOEXCEPTION);
+		for(std::int32_t v=0; v < header.num_vertices; ++v)
+			if(offsets[v+1] < offsets[v])
+				throw std::ios_base::failure(IOEXCEPTION);
+		for(std::uint64_t i=0; i < header.num_edges; ++i)
+			if(destinations[i] < 0 || destinations[i] >= header.num_vertices)
+				throw std::ios_base::failure(IOEXCEPTION);
+	}
+
+	return CSRGraph<TVertexValue, TEdgeWeight>(storage, header.num_vertices, offsets, destinations,
+		reinterpret_cast<const TEdgeWeight*>(data + layout.weights),
+		has_reverse_weights ? reinterpret_cast<const TEdgeWeight*>(data + layout.reverse_weights) : nullptr,
+		reinterpret_cast<const TVertexValue*>(data + layout.values), (header.flags & FLAG_SYMMETRIC) != 0);
+}
+
+//       ,     .
+//  ,       .
+template<typename TVertexValue, typename TEdgeWeight>
+CSRGraph<TVertexValue, TEdgeWeight> GraphBinaryIO::map_file(const std::string& file_name, bool verify_checksum)
+{
+	std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(file_name);
+	return from_memory<TVertexValue, TEdgeWeight>(file, file->get_data(), file->get_size(), verify_checksum);
+}
+
+//       ;   ,     .
+template<typename TVertexValue, typename TEdgeWeight>
+CSRGraph<TVertexValue, TEdgeWeight> GraphBinaryIO::from_stream(std::istream& in_stream, bool verify_checksum)
+{
+	Header header;
+	if(!in_stream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		header.num_vertices < 0 || (header.num_edges >> 48) != 0)
+		throw std::ios_base::failure(IOEXCEPTION);
+	std::uint64_t size = get_layout<TVertexValue, TEdgeWeight>(header.num_vertices, header.num_edges,
+		(header.flags & FLAG_REVERSE_WEIGHTS) != 0).file_size;
+	check_header<TVertexValue, TEdgeWeight>(header, size);
+
+	std::shared_ptr<std::vector<std::uint64_t>> buffer = std::make_shared<std::vector<std::uint64_t>>(
+		static_cast<size_t>(size/sizeof(std::uint64_t)));
+	char* data = reinterpret_cast<char*>(&(*buffer)[0]);
+	std::memcpy(data, &header, sizeof(header));
+	if(!in_stream.read(data + sizeof(header), static_cast<std::streamsize>(size - sizeof(header))))
+		throw std::ios_base::failure(IOEXCEPTION);
+	return from_memory<TVertexValue, TEdgeWeight>(buffer, data, size, verify_checksum);
+}
+#endif
@@ -0,0 +1,201 @@
+#pragma once
+#ifndef GRAPHGEN_H
+#define GRAPHGEN_H
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "graphio.h"
+
+//      .
+//        ,    GraphIO:
+// Graph<point,double> -   ,        ,
+//      AStarEuclidianHeuristic;
+// Graph<int,int> -   ,   -     1,
+//    (   )  .
+//    ,      [1, 1 + detour) -   ,
+//     .      seed.
+class GraphGenerator
+{
+public:
+	template<typename TVertexValue, typename TEdgeWeight>
+	static Graph<TVertexValue, TEdgeWeight> grid(int width, int height, unsigned int seed, double detour = 0.5);
+	template<typename TVertexValue, typename TEdgeWeight>
+	static Graph<TVertexValue, TEdgeWeight> random_geometric(int num_vertices, double average_degree,
+		unsigned int seed, double detour = 0.5);
+	template<typename TVertexValue, typename TEdgeWeight>
+	static Graph<TVertexValue, TEdgeWeight> power_law(int num_vertices, int edges_per_vertex,
+		unsigned int seed, double detour = 0.5);
+
+private:
+	// ,       .
+	static const int INTEGER_WEIGHT_SCALE = 10;
+
+	static void set_value(const point& coordinates, point& value) { value = coordinates; }
+	static void set_value(const point&, int& value) { value = 0; }
+	static void set_weight(double length, double& weight) { weight = length; }
+	static void set_weight(double length, int& weight)
+	{
+		weight = std::max(1, static_cast<int>(std::ceil(length*INTEGER_WEIGHT_SCALE)));
+	}
+
+	template<typename TVertexValue, typename TEdgeWeight>
+	static Graph<TVertexValue, TEdgeWeight> build(const std::vector<point>& coordinates,
+		const std::vector<std::pair<int, int>>& pairs, std::mt19937& generator, double detour);
+};
+
+//          ,   .
+template<typename TVertexValue, typename TEdgeWeight>
+Graph<TVertexValue, TEdgeWeight> GraphGenerator::build(const std::vector<point>& coordinates,
+	const std::vector<std::pair<int, int>>& pairs, std::mt19937& generator, double detour)
+{
+	const int num_vertices = static_cast<int>(coordinates.size());
+	Graph<TVertexValue, TEdgeWeight> graph(num_vertices);
+	TVertexValue value;
+	for(int v=0; v < num_vertices; ++v)
+	{
+		set_value(coordinates[v], value);
+		graph.set_vertex_value(v, value);
+	}
+
+	std::uniform_real_distribution<double> random_factor(1.0, 1.0 + detour);
+	std::vector<EdgeListEntry<TEdgeWeight>> edges(pairs.size());
+	for(size_t i=0; i < pairs.size(); ++i)
+	{
+		const point& origin = coordinates[pairs[i].first];
+		const point& destination = coordinates[pairs[i].second];
+		double x = origin.first - destination.first;
+		double y = origin.second - destination.second;
+		edges[i].origin = pairs[i].first;
+		edges[i].destination = pairs[i].second;
+		set_weight(std::sqrt(x*x + y*y)*random_factor(generator), edges[i].weight);
+	}
+	graph.add_edges(edges);
+	return graph;
+}
+
+//  width x height   1,      ;   (x, y) - y*width + x.
+template<typename TVertexValue, typename TEdgeWeight>
+Graph<TVertexValue, TEdgeWeight> GraphGenerator::grid(int width, int height, unsigned int seed, double detour)
+{
+	std::mt19937 generator(seed);
+	std::vector<point> coordinates(static_cast<size_t>(width)*height);
+	std::vector<std::pair<int, int>> pairs;
+	pairs.reserve(2*coordinates.size());
+	for(int y=0; y < height; ++y)
+		for(int x=0; x < width; ++x)
+		{
+			int vertex = y*width + x;
+			coordinates[vertex] = point(x, y);
+			if(x + 1 < width)
+				pairs.push_back(std::make_pair(vertex, vertex + 1));
+			if(y + 1 < height)
+				pairs.push_back(std::make_pair(vertex, vertex + width));
+		}
+	return build<TVertexValue, TEdgeWeight>(coordinates, pairs, generator, detour);
+}
+
+//   :        sqrt(num_vertices),
+//          ,      average_degree.
+//         ,     O(V + E).
+template<typename TVertexValue, typename TEdgeWeight>
+Graph<TVertexValue, TEdgeWeight> GraphGenerator::random_geometric(int num_vertices, double average_degree,
+	unsigned int seed, double detour)
+{
+	std::mt19937 generator(seed);
+	const double side = std::sqrt(static_cast<double>(num_vertices));
+	const double radius = std::sqrt(average_degree/3.14159265358979323846);
+	std::uniform_real_distribution<double> random_coordinate(0.0, side);
+	std::vector<point> coordinates(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+	{
+		double x = random_coordinate(generator);
+		coordinates[v] = point(x, random_coordinate(generator));
+	}
+
+	const int num_cells = std::max(1, static_cast<int>(side/radius));
+	const double cell_size = side/num_cells;
+	std::vector<std::vector<int>> cells(static_cast<size_t>(num_cells)*num_cells);
+	for(int v=0; v < num_vertices; ++v)
+	{
+		int cell_x = std::min(num_cells - 1, static_cast<int>(coordinates[v].first/cell_size));
+		int cell_y = std::min(num_cells - 1, static_cast<int>(coordinates[v].second/cell_size));
+		cells[cell_y*num_cells + cell_x].push_back(v);
+	}
+
+	std::vector<std::pair<int, int>> pairs;
+	for(int cell_y=0; cell_y < num_cells; ++cell_y)
+		for(int cell_x=0; cell_x < num_cells; ++cell_x)
+		{
+			const std::vector<int>& cell = cells[cell_y*num_cells + cell_x];
+			for(int other_y=std::max(0, cell_y - 1); other_y <= std::min(num_cells - 1, cell_y + 1); ++other_y)
+				for(int other_x=std::max(0, cell_x - 1); other_x <= std::min(num_cells - 1, cell_x + 1); ++other_x)
+				{
+					const std::vector<int>& other_cell = cells[other_y*num_cells + other_x];
+					for(size_t i=0; i < cell.size(); ++i)
+						for(size_t j=0; j < other_cell.size(); ++j)
+						{
+							if(cell[i] >= other_cell[j])
+								continue;
+							double x = coordinates[cell[i]].first - coordinates[other_cell[j]].first;
+							double y = coordinates[cell[i]].second - coordinates[other_cell[j]].second;
+							if(x*x + y*y <= radius*radius)
+								pairs.push_back(std::make_pair(cell[i], other_cell[j]));
+						}
+				}
+		}
+	return build<TVertexValue, TEdgeWeight>(coordinates, pairs, generator, detour);
+}
+
+//      (  - ):   
+//   edges_per_vertex  ,   ,   .
+//           sqrt(num_vertices).
+template<typename TVertexValue, typename TEdgeWeight>
+Graph<TVertexValue, TEdgeWeight> GraphGenerator::power_law(int num_vertices, int edges_per_vertex,
+	unsigned int seed, double detour)
+{
+	std::mt19937 generator(seed);
+	const double side = std::sqrt(static_cast<double>(num_vertices));
+	std::uniform_real_distribution<double> random_coordinate(0.0, side);
+	std::vector<point> coordinates(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+	{
+		double x = random_coordinate(generator);
+		coordinates[v] = point(x, random_coordinate(generator));
+	}
+
+	//       endpoints,     endpoints
+	//    ,   .
+	std::vector<std::pair<int, int>> pairs;
+	std::vector<int> endpoints;
+	pairs.reserve(static_cast<size_t>(num_vertices)*edges_per_vertex);
+	endpoints.reserve(2*pairs.capacity());
+	const int num_seed_vertices = std::min(num_vertices, edges_per_vertex + 1);
+	for(int v=1; v < num_seed_vertices; ++v)
+	{
+		pairs.push_back(std::make_pair(v - 1, v));
+		endpoints.push_back(v - 1);
+		endpoints.push_back(v);
+	}
+	std::vector<int> targets;
+	for(int v=num_seed_vertices; v < num_vertices; ++v)
+	{
+		std::uniform_int_distribution<size_t> random_endpoint(0, endpoints.size() - 1);
+		targets.clear();
+		while(static_cast<int>(targets.size()) < edges_per_vertex)
+		{
+			int target = endpoints[random_endpoint(generator)];
+			if(std::find(targets.begin(), targets.end(), target) == targets.end())
+				targets.push_back(target);
+		}
+		for(size_t i=0; i < targets.size(); ++i)
+		{
+			pairs.push_back(std::make_pair(v, targets[i]));
+			endpoints.push_back(v);
+			endpoints.push_back(targets[i]);
+		}
+	}
+	return build<TVertexValue, TEdgeWeight>(coordinates, pairs, generator, detour);
+}
+#endif
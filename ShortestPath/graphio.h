@@ -4,9 +4,15 @@
 
 #define IOEXCEPTION "Incorrect data structure in istream."
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <iostream>
 #include <math.h>
+#include <vector>
+#include <string>
 #include "astar.h"
+#include "gridgraph.h"
 
 class GraphIO;
 class AStarEuclidianHeuristic;
@@ -18,13 +24,31 @@ class GraphIO
 public:
 	static Graph<int,int> from_stream_int(std::istream& in_stream);
 	static Graph<point,double> from_stream_double_double(std::istream& in_stream);
+	static Graph<int,int> bulk_from_stream_int(std::istream& in_stream);
+	static Graph<int,int> bulk_from_stream_int(std::istream& in_stream, ThreadPool& pool);
+	static Graph<point,double> bulk_from_stream_double_double(std::istream& in_stream);
+	static Graph<point,double> bulk_from_stream_double_double(std::istream& in_stream, ThreadPool& pool);
+	static GridGraph grid_from_stream(std::istream& in_stream);
+private:
+	static void read_all(std::istream& in_stream, std::vector<char>& buffer);
+	static const char* skip_blanks(const char* current, const char* last);
+	static const char* find_line_end(const char* current, const char* last);
+	static const char* next_line(const char* current, const char* last);
+	static const char* skip_blank_lines(const char* current, const char* last);
+	template<typename TNumber>
+	static bool parse_number(const char*& current, const char* last, TNumber& value);
+	static const char* parse_num_vertices(const char* first, const char* last, int& num_vertices);
+	template<typename TRecord, typename TParser>
+	static void parse_lines(const char* first, const char* last, ThreadPool& pool,
+		const TParser& parse_line, std::vector<TRecord>& records);
 };
 
 //     A*       .
-class AStarEuclidianHeuristic : public AStarSearch<point, double>::AStarDefaultHeuristic
+class AStarEuclidianHeuristic : public AStarHeuristic<AStarEuclidianHeuristic, double>
 {
 public:
-	virtual double get_cost(const Graph<point, double> graph, int start, int goal) const override;
+	template<typename TGraph>
+	double get_cost(const TGraph& graph, int start, int goal) const;
 };
 
 //   :  ,  .
@@ -85,7 +109,261 @@ inline Graph<point,double> GraphIO::from_stream_double_double(std::istream& in_s
 	return graph;
 }
 
-inline double AStarEuclidianHeuristic::get_cost(const Graph<point, double> graph, int start, int goal) const
+//   :     Moving AI (.map).
+//
+// type octile
+// height 
+// width 
+// map
+// _ ( )
+//		...
+// _
+//
+//   - ,    y = 0.   - '.', 'G'  'S',
+//   ('@', 'O', 'T', 'W')   .
+inline GridGraph GraphIO::grid_from_stream(std::istream& in_stream)
+{
+	std::string keyword, type;
+	int width = -1, height = -1;
+	if(!(in_stream >> keyword >> type) || keyword != "type")
+		throw std::ios_base::failure(IOEXCEPTION);
+	while(in_stream >> keyword && keyword != "map")
+	{
+		if(keyword == "height" && in_stream >> height)
+			continue;
+		if(keyword == "width" && in_stream >> width)
+			continue;
+		throw std::ios_base::failure(IOEXCEPTION);
+	}
+	if(keyword != "map" || width <= 0 || height <= 0)
+		throw std::ios_base::failure(IOEXCEPTION);
+
+	GridGraph grid(width, height);
+	std::string row;
+	for(int y=0; y < height; ++y)
+	{
+		if(!(in_stream >> row) || static_cast<int>(row.size()) != width)
+			throw std::ios_base::failure(IOEXCEPTION);
+		for(int x=0; x < width; ++x)
+			if(row[x] != '.' && row[x] != 'G' && row[x] != 'S')
+				grid.set_blocked(x, y, true);
+	}
+	return grid;
+}
+
+//      from_stream_int.
+//   ,   std::from_chars    ,
+//           add_edges.
+//    from_stream_int,  ,    ,  
+//  ,     std::ios_base::failure(IOEXCEPTION).
+inline Graph<int,int> GraphIO::bulk_from_stream_int(std::istream& in_stream)
+{
+	ThreadPool pool;
+	return bulk_from_stream_int(in_stream, pool);
+}
+
+inline Graph<int,int> GraphIO::bulk_from_stream_int(std::istream& in_stream, ThreadPool& pool)
+{
+	std::vector<char> buffer;
+	read_all(in_stream, buffer);
+	const char* first = buffer.empty() ? nullptr : &buffer[0];
+	const char* last = first + buffer.size();
+
+	int num_vertices;
+	first = parse_num_vertices(first, last, num_vertices);
+
+	std::vector<EdgeListEntry<int>> edges;
+	parse_lines(first, last, pool, [](const char* current, const char* line_end, EdgeListEntry<int>& edge)
+	{
+		return parse_number(current, line_end, edge.origin) && parse_number(current, line_end, edge.destination) &&
+			parse_number(current, line_end, edge.weight) && skip_blanks(current, line_end) == line_end;
+	}, edges);
+
+	Graph<int,int> graph(num_vertices);
+	graph.add_edges(edges);
+	return graph;
+}
+
+//      from_stream_double_double; . bulk_from_stream_int.
+//          .
+inline Graph<point,double> GraphIO::bulk_from_stream_double_double(std::istream& in_stream)
+{
+	ThreadPool pool;
+	return bulk_from_stream_double_double(in_stream, pool);
+}
+
+inline Graph<point,double> GraphIO::bulk_from_stream_double_double(std::istream& in_stream, ThreadPool& pool)
+{
+	std::vector<char> buffer;
+	read_all(in_stream, buffer);
+	const char* first = buffer.empty() ? nullptr : &buffer[0];
+	const char* last = first + buffer.size();
+
+	int num_vertices;
+	first = parse_num_vertices(first, last, num_vertices);
+
+	//       :  num_vertices  .
+	const char* vertices_last = first;
+	for(int i=0; i < num_vertices; ++i)
+	{
+		vertices_last = skip_blank_lines(vertices_last, last);
+		if(vertices_last == last)
+			throw std::ios_base::failure(IOEXCEPTION);
+		vertices_last = next_line(vertices_last, last);
+	}
+
+	typedef std::pair<int, point> VertexRecord;
+	std::vector<VertexRecord> vertex_records;
+	parse_lines(first, vertices_last, pool, [](const char* current, const char* line_end, VertexRecord& record)
+	{
+		return parse_number(current, line_end, record.first) && parse_number(current, line_end, record.second.first) &&
+			parse_number(current, line_end, record.second.second) && skip_blanks(current, line_end) == line_end;
+	}, vertex_records);
+
+	std::vector<point> values(num_vertices);
+	for(size_t i=0; i < vertex_records.size(); ++i)
+		if(vertex_records[i].first >= 0 && vertex_records[i].first < num_vertices)
+			values[vertex_records[i].first] = vertex_records[i].second;
+
+	std::vector<EdgeListEntry<double>> edges;
+	parse_lines(vertices_last, last, pool, [&values, num_vertices](const char* current, const char* line_end, EdgeListEntry<double>& edge)
+	{
+		if(!parse_number(current, line_end, edge.origin) || !parse_number(current, line_end, edge.destination) ||
+			skip_blanks(current, line_end) != line_end)
+			return false;
+		if(edge.origin >= 0 && edge.origin < num_vertices && edge.destination >= 0 && edge.destination < num_vertices)
+		{
+			double x = values[edge.origin].first - values[edge.destination].first;
+			double y = values[edge.origin].second - values[edge.destination].second;
+			edge.weight = sqrt(x*x + y*y);
+		}
+		return true;
+	}, edges);
+
+	Graph<point,double> graph(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+		graph.set_vertex_value(v, values[v]);
+	graph.add_edges(edges);
+	return graph;
+}
+
+inline void GraphIO::read_all(std::istream& in_stream, std::vector<char>& buffer)
+{
+	const size_t chunk_size = 1 << 20;
+	size_t size = 0;
+	buffer.clear();
+	while(in_stream)
+	{
+		buffer.resize(size + chunk_size);
+		in_stream.read(&buffer[size], chunk_size);
+		size += static_cast<size_t>(in_stream.gcount());
+	}
+	buffer.resize(size);
+}
+
+//  ,        .
+inline const char* GraphIO::skip_blanks(const char* current, const char* last)
+{
+	while(current < last && (*current == ' ' || *current == '\t' || *current == '\r'))
+		++current;
+	return current;
+}
+
+inline const char* GraphIO::find_line_end(const char* current, const char* last)
+{
+	const char* line_end = current < last ? static_cast<const char*>(std::memchr(current, '\n', last - current)) : nullptr;
+	return line_end == nullptr ? last : line_end;
+}
+
+inline const char* GraphIO::next_line(const char* current, const char* last)
+{
+	const char* line_end = find_line_end(current, last);
+	return line_end == last ? last : line_end + 1;
+}
+
+//    ,  -   ,  last.
+inline const char* GraphIO::skip_blank_lines(const char* current, const char* last)
+{
+	while(current < last)
+	{
+		const char* line_end = find_line_end(current, last);
+		if(skip_blanks(current, line_end) != line_end)
+			break;
+		current = next_line(current, last);
+	}
+	return current;
+}
+
+//       current  .
+template<typename TNumber>
+inline bool GraphIO::parse_number(const char*& current, const char* last, TNumber& value)
+{
+	current = skip_blanks(current, last);
+	std::from_chars_result result = std::from_chars(current, last, value);
+	if(result.ec != std::errc())
+		return false;
+	current = result.ptr;
+	return true;
+}
+
+//            .
+inline const char* GraphIO::parse_num_vertices(const char* first, const char* last, int& num_vertices)
+{
+	first = skip_blank_lines(first, last);
+	const char* line_end = find_line_end(first, last);
+	if(first == last || !parse_number(first, line_end, num_vertices) || skip_blanks(first, line_end) != line_end ||
+		num_vertices < 0)
+		throw std::ios_base::failure(IOEXCEPTION);
+	return next_line(first, last);
+}
+
+//  [first, last)         .
+// parse_line(,  , )        false,
+//   .     .
+template<typename TRecord, typename TParser>
+inline void GraphIO::parse_lines(const char* first, const char* last, ThreadPool& pool,
+	const TParser& parse_line, std::vector<TRecord>& records)
+{
+	const size_t min_block_size = 1 << 16;
+	const size_t size = static_cast<size_t>(last - first);
+	const size_t num_blocks = std::min(pool.get_num_threads()*8, size/min_block_size + 1);
+
+	std::vector<const char*> bounds(num_blocks + 1, last);
+	bounds[0] = first;
+	for(size_t i=1; i < num_blocks; ++i)
+		bounds[i] = next_line(std::max(first + size/num_blocks*i, bounds[i-1]), last);
+
+	std::vector<std::vector<TRecord>> block_records(num_blocks);
+	pool.parallel_for(num_blocks, [&](size_t block, size_t)
+	{
+		const char* block_last = bounds[block+1];
+		for(const char* line=bounds[block]; line < block_last; line=next_line(line, block_last))
+		{
+			const char* line_end = find_line_end(line, block_last);
+			const char* current = skip_blanks(line, line_end);
+			if(current == line_end)
+				continue;
+			TRecord record;
+			if(!parse_line(current, line_end, record))
+				throw std::ios_base::failure(IOEXCEPTION);
+			block_records[block].push_back(record);
+		}
+	});
+
+	size_t num_records = 0;
+	for(size_t i=0; i < num_blocks; ++i)
+		num_records += block_records[i].size();
+	records.clear();
+	records.reserve(num_records);
+	for(size_t i=0; i < num_blocks; ++i)
+	{
+		records.insert(records.end(), block_records[i].begin(), block_records[i].end());
+		std::vector<TRecord>().swap(block_records[i]);
+	}
+}
+
+template<typename TGraph>
+inline double AStarEuclidianHeuristic::get_cost(const TGraph& graph, int start, int goal) const
 {
 	point start_point, goal_point;
 	graph.get_vertex_value(start, start_point);
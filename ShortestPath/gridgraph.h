@@ -0,0 +1,273 @@
+#pragma once
+#ifndef GRIDGRAPH_H
+#define GRIDGRAPH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include "astar.h"
+
+//   .      get_neighbor_range     :
+//      ,      .
+class GridNeighborRange
+{
+	friend class GridGraph;
+
+	int destinations[8];
+	double weights[8];
+	size_t num_edges;
+public:
+	GridNeighborRange() : num_edges(0) { }
+	size_t size() const { return num_edges; }
+	int destination(size_t i) const { return destinations[i]; }
+	double weight(size_t i) const { return weights[i]; }
+	//   :     .
+	double reverse_weight(size_t i) const { return weights[i]; }
+};
+
+//     width x height    .
+//   (x, y) - y*width + x,   -   (x, y),   Graph<point,double>.
+//   :       (   ),  
+//   .       1,   - DIAGONAL_COST;
+//    ,     ,     (  ).
+//     ,    .    GraphIO::grid_from_stream.
+//    -     ,  get_blocked_row  get_blocked_column
+//  64      -   ( JumpPointSearch
+//  );   10000 x 10000  25 .
+//     Graph,       AStarSearch<point,double>;
+//     JumpPointSearch (. jps.h),       .
+class GridGraph
+{
+	int width;
+	int height;
+	std::vector<std::uint64_t> blocked_cells;
+	std::vector<std::uint64_t> blocked_cells_by_columns;
+	std::uint64_t version;
+
+	static std::uint64_t get_blocked_bits(const std::vector<std::uint64_t>& cells, const int num_lines,
+		const int line_length, const int line, const int first);
+public:
+	typedef GridNeighborRange NeighborRange;
+	static constexpr double DIAGONAL_COST = 1.4142135623730951;
+
+	GridGraph(int width, int height);
+	int get_width() const { return width; }
+	int get_height() const { return height; }
+	int get_num_vertices() const { return width*height; }
+	//      set_blocked (. Graph::get_version).
+	std::uint64_t get_version() const { return version; }
+	int get_vertex(const int x, const int y) const;
+	bool get_coordinates(const int vertex, int& x, int& y) const;
+	bool is_free(const int x, const int y) const;
+	bool set_blocked(const int x, const int y, const bool is_blocked);
+	std::uint64_t get_blocked_row(const int x, const int y) const;
+	std::uint64_t get_blocked_column(const int x, const int y) const;
+	bool get_neighbor_range(const int vertex, NeighborRange& neighbors) const;
+	bool contains_edge(const int vertex_origin, const int vertex_destination) const;
+	bool get_edge_weight(const int vertex_origin, const int vertex_destination, double& weight) const;
+	bool get_vertex_value(const int vertex, std::pair<double, double>& value) const;
+	void print(std::ostream& out_stream) const;
+};
+
+//        :   
+//     ( ).   -  .
+//     ,   GridGraph   ,  AStarEuclidianHeuristic.
+class AStarOctileHeuristic : public AStarHeuristic<AStarOctileHeuristic, double>
+{
+public:
+	template<typename TGraph>
+	double get_cost(const TGraph& graph, int start, int goal) const;
+};
+
+//  ,     .
+inline GridGraph::GridGraph(int width, int height)
+	: width(width), height(height),
+	blocked_cells((static_cast<size_t>(width)*height + 63)/64, 0), blocked_cells_by_columns(blocked_cells.size(), 0),
+	version(get_next_graph_version())
+{
+}
+
+//  -1     .
+inline int GridGraph::get_vertex(const int x, const int y) const
+{
+	if(x >= width || y >= height || x < 0 || y < 0)
+		return -1;
+	return y*width + x;
+}
+
+inline bool GridGraph::get_coordinates(const int vertex, int& x, int& y) const
+{
+	if(vertex >= get_num_vertices() || vertex < 0)
+		return false;
+	x = vertex % width;
+	y = vertex / width;
+	return true;
+}
+
+//      .
+inline bool GridGraph::is_free(const int x, const int y) const
+{
+	if(x >= width || y >= height || x < 0 || y < 0)
+		return false;
+	size_t cell = static_cast<size_t>(y)*width + x;
+	return ((blocked_cells[cell >> 6] >> (cell & 63)) & 1) == 0;
+}
+
+inline bool GridGraph::set_blocked(const int x, const int y, const bool is_blocked)
+{
+	if(x >= width || y >= height || x < 0 || y < 0)
+		return false;
+	size_t cell = static_cast<size_t>(y)*width + x;
+	size_t transposed_cell = static_cast<size_t>(x)*height + y;
+	if(is_blocked)
+	{
+		blocked_cells[cell >> 6] |= static_cast<std::uint64_t>(1) << (cell & 63);
+		blocked_cells_by_columns[transposed_cell >> 6] |= static_cast<std::uint64_t>(1) << (transposed_cell & 63);
+	}
+	else
+	{
+		blocked_cells[cell >> 6] &= ~(static_cast<std::uint64_t>(1) << (cell & 63));
+		blocked_cells_by_columns[transposed_cell >> 6] &= ~(static_cast<std::uint64_t>(1) << (transposed_cell & 63));
+	}
+	version = get_next_graph_version();
+	return true;
+}
+
+//   first, ..., first + 63  line    num_lines   line_length.
+//      .
+inline std::uint64_t GridGraph::get_blocked_bits(const std::vector<std::uint64_t>& cells, const int num_lines,
+	const int line_length, const int line, const int first)
+{
+	const std::uint64_t all_blocked = ~static_cast<std::uint64_t>(0);
+	if(line < 0 || line >= num_lines || first >= line_length || first <= -64)
+		return all_blocked;
+
+	//   [0, line_length)    outside.
+	int begin = std::max(first, 0);
+	int end = std::min(first + 64, line_length);
+	std::uint64_t inside = end - begin == 64 ? all_blocked : ((static_cast<std::uint64_t>(1) << (end - begin)) - 1);
+	std::uint64_t outside = ~(inside << (begin - first));
+
+	size_t bit = static_cast<size_t>(line)*line_length + begin;
+	size_t word = bit >> 6;
+	int offset = static_cast<int>(bit & 63);
+	std::uint64_t bits = cells[word] >> offset;
+	if(offset != 0 && word + 1 < cells.size())
+		bits |= cells[word + 1] << (64 - offset);
+	return ((bits & inside) << (begin - first)) | outside;
+}
+
+//    (x, y), ..., (x + 63, y):  i   (x + i, y).
+inline std::uint64_t GridGraph::get_blocked_row(const int x, const int y) const
+{
+	return get_blocked_bits(blocked_cells, height, width, y, x);
+}
+
+//    (x, y), ..., (x, y + 63):  i   (x, y + i).
+inline std::uint64_t GridGraph::get_blocked_column(const int x, const int y) const
+{
+	return get_blocked_bits(blocked_cells_by_columns, width, height, x, y);
+}
+
+//    :   ,   .
+inline bool GridGraph::get_neighbor_range(const int vertex, NeighborRange& neighbors) const
+{
+	int x, y;
+	if(!get_coordinates(vertex, x, y))
+		return false;
+	neighbors.num_edges = 0;
+	if(!is_free(x, y))
+		return true;
+
+	static const int directions[4][2] = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
+	bool is_step_free[4];
+	for(int i=0; i < 4; ++i)
+	{
+		is_step_free[i] = is_free(x + directions[i][0], y + directions[i][1]);
+		if(is_step_free[i])
+		{
+			neighbors.destinations[neighbors.num_edges] = vertex + directions[i][1]*width + directions[i][0];
+			neighbors.weights[neighbors.num_edges] = 1.0;
+			++neighbors.num_edges;
+		}
+	}
+	//    i  i+1.
+	for(int i=0; i < 4; ++i)
+	{
+		int next = (i + 1) % 4;
+		int dx = directions[i][0] + directions[next][0];
+		int dy = directions[i][1] + directions[next][1];
+		if(is_step_free[i] && is_step_free[next] && is_free(x + dx, y + dy))
+		{
+			neighbors.destinations[neighbors.num_edges] = vertex + dy*width + dx;
+			neighbors.weights[neighbors.num_edges] = DIAGONAL_COST;
+			++neighbors.num_edges;
+		}
+	}
+	return true;
+}
+
+inline bool GridGraph::contains_edge(const int vertex_origin, const int vertex_destination) const
+{
+	double weight;
+	return get_edge_weight(vertex_origin, vertex_destination, weight);
+}
+
+inline bool GridGraph::get_edge_weight(const int vertex_origin, const int vertex_destination, double& weight) const
+{
+	int origin_x, origin_y, destination_x, destination_y;
+	if(!get_coordinates(vertex_origin, origin_x, origin_y) ||
+		!get_coordinates(vertex_destination, destination_x, destination_y))
+		return false;
+	int dx = destination_x - origin_x;
+	int dy = destination_y - origin_y;
+	if(std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0))
+		return false;
+	if(!is_free(origin_x, origin_y) || !is_free(destination_x, destination_y))
+		return false;
+	if(dx != 0 && dy != 0)
+	{
+		if(!is_free(origin_x + dx, origin_y) || !is_free(origin_x, origin_y + dy))
+			return false;
+		weight = DIAGONAL_COST;
+	}
+	else
+		weight = 1.0;
+	return true;
+}
+
+inline bool GridGraph::get_vertex_value(const int vertex, std::pair<double, double>& value) const
+{
+	int x, y;
+	if(!get_coordinates(vertex, x, y))
+		return false;
+	value = std::make_pair(static_cast<double>(x), static_cast<double>(y));
+	return true;
+}
+
+//   : '.' -  , '@' - .
+inline void GridGraph::print(std::ostream& out_stream) const
+{
+	for(int y=0; y < height; ++y)
+	{
+		for(int x=0; x < width; ++x)
+			out_stream << (is_free(x, y) ? '.' : '@');
+		out_stream << std::endl;
+	}
+}
+
+template<typename TGraph>
+inline double AStarOctileHeuristic::get_cost(const TGraph& graph, int start, int goal) const
+{
+	std::pair<double, double> start_point, goal_point;
+	graph.get_vertex_value(start, start_point);
+	graph.get_vertex_value(goal, goal_point);
+	double dx = std::abs(start_point.first - goal_point.first);
+	double dy = std::abs(start_point.second - goal_point.second);
+	return std::max(dx, dy) + (GridGraph::DIAGONAL_COST - 1.0)*std::min(dx, dy);
+}
+#endif
@@ -0,0 +1,409 @@
+#pragma once
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <algorithm>
+#include <set>
+#include <list>
+#include <limits>
+#include <vector>
+#include "graph.h"
+#include "astar.h"
+#include "pqueue.h"
+
+//        (D* Lite)  ,   .
+//       find_shortest_path.   
+// (set_edge_weight, add_edge, remove_edge)      notify_edge_changed;
+//         ,    ,
+//     .       (,   ),
+//     ;     .
+//       : g(v) -    v    ,
+// rhs(v) -   ,    v. ,   g(v) != rhs(v),   
+//   [min(g, rhs) + h(v) + km; min(g, rhs)],  h(v) -    v   ,
+//  km         .
+//   ,    AStarSearch,  <<>>    num_vertices,
+//        .
+//   (v, w)     v,         .
+//  (. AStarHeuristic)   ;      
+//   (LPA*  ).   ,   .
+template<typename TVertexValue, typename TEdgeWeight,
+	typename THeuristic = typename AStarSearch<TVertexValue, TEdgeWeight>::AStarDefaultHeuristic>
+class IncrementalSearch
+{
+	//     :    ,  .
+	//   ,     ,   :  , 
+	//   ,           rhs
+	//         g.    
+	//      .
+	struct Cost
+	{
+		TEdgeWeight weight;
+		int num_edges;
+		bool operator<(const Cost& other) const
+		{
+			if(weight < other.weight)
+				return true;
+			if(other.weight < weight)
+				return false;
+			return num_edges < other.num_edges;
+		}
+		bool operator==(const Cost& other) const { return weight == other.weight && num_edges == other.num_edges; }
+		bool operator!=(const Cost& other) const { return !(*this == other); }
+	};
+
+	//    ;  .   -  min(g, rhs),
+	//     h(v)  km,  -  min(g, rhs).
+	struct Key
+	{
+		Cost primary;
+		TEdgeWeight secondary;
+		bool operator<(const Key& other) const
+		{
+			if(primary < other.primary)
+				return true;
+			if(other.primary < primary)
+				return false;
+			return secondary < other.secondary;
+		}
+	};
+
+	const Graph<TVertexValue, TEdgeWeight>& graph;
+	THeuristic heuristic;
+	int num_vertices;
+	int virtual_start;
+	std::set<int> start_group;
+	std::set<int> goal_group;
+	std::vector<Cost> costs;
+	std::vector<Cost> lookahead_costs;
+	std::vector<unsigned char> is_start;
+	std::vector<unsigned char> is_goal;
+	std::vector<TEdgeWeight> heuristic_costs;
+	std::vector<unsigned int> heuristic_generations;
+	unsigned int heuristic_generation;
+	IndexedPriorityQueue<Key> queue;
+	TEdgeWeight key_modifier;
+	bool is_initialized;
+	size_t num_settled;
+
+	static TEdgeWeight infinity() { return std::numeric_limits<TEdgeWeight>::max(); }
+	static TEdgeWeight add_costs(const TEdgeWeight& first, const TEdgeWeight& second);
+	static Cost infinite_cost();
+	static Cost add_edge(const TEdgeWeight& weight, const Cost& cost);
+	void initialize();
+	TEdgeWeight get_heuristic_cost(const int vertex);
+	Key calculate_key(const int vertex);
+	void update_vertex(const int vertex);
+	void update_predecessors(const int vertex);
+	void compute_shortest_path();
+	bool is_group_valid(const std::set<int>& group) const;
+
+	IncrementalSearch(const IncrementalSearch&);
+	IncrementalSearch& operator=(const IncrementalSearch&);
+public:
+	explicit IncrementalSearch(const Graph<TVertexValue, TEdgeWeight>& graph, const THeuristic& heuristic = THeuristic());
+	bool set_start_group(const std::set<int>& start_group);
+	bool set_goal_group(const std::set<int>& goal_group);
+	bool notify_edge_changed(const int vertex_origin, const int vertex_destination);
+	bool find_shortest_path(std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	//  ,      .
+	size_t get_num_settled() const { return num_settled; }
+};
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::IncrementalSearch(
+	const Graph<TVertexValue, TEdgeWeight>& graph, const THeuristic& heuristic)
+	: graph(graph), heuristic(heuristic), num_vertices(graph.get_num_vertices()), virtual_start(num_vertices),
+	is_start(num_vertices + 1, 0), is_goal(num_vertices + 1, 0),
+	heuristic_costs(num_vertices + 1), heuristic_generations(num_vertices + 1, 0), heuristic_generation(1),
+	queue(num_vertices + 1), key_modifier(TEdgeWeight()), is_initialized(false), num_settled(0)
+{
+}
+
+//  ,      .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+inline TEdgeWeight IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::add_costs(
+	const TEdgeWeight& first, const TEdgeWeight& second)
+{
+	if(first == infinity() || second == infinity())
+		return infinity();
+	return first + second;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+inline typename IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::Cost
+	IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::infinite_cost()
+{
+	Cost cost = { infinity(), 0 };
+	return cost;
+}
+
+//  ,    .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+inline typename IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::Cost
+	IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::add_edge(const TEdgeWeight& weight, const Cost& cost)
+{
+	if(weight == infinity() || cost.weight == infinity())
+		return infinite_cost();
+	Cost sum = { weight + cost.weight, cost.num_edges + 1 };
+	return sum;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+bool IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::is_group_valid(const std::set<int>& group) const
+{
+	for(std::set<int>::const_iterator i=group.begin(); i != group.end(); ++i)
+		if(*i >= num_vertices || *i < 0)
+			return false;
+	return true;
+}
+
+//    .            ;
+//          ,   km 
+//     : max     s'    s'   .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+bool IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::set_start_group(const std::set<int>& start_group)
+{
+	if(!is_group_valid(start_group))
+		return false;
+
+	if(is_initialized && !this->start_group.empty() && !start_group.empty())
+	{
+		TEdgeWeight max_shift = TEdgeWeight();
+		for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+		{
+			TEdgeWeight shift = heuristic.get_min_cost(graph, *i, this->start_group);
+			if(max_shift < shift)
+				max_shift = shift;
+		}
+		key_modifier = key_modifier + max_shift;
+	}
+
+	for(std::set<int>::const_iterator i=this->start_group.begin(); i != this->start_group.end(); ++i)
+		is_start[*i] = 0;
+	this->start_group = start_group;
+	for(std::set<int>::const_iterator i=this->start_group.begin(); i != this->start_group.end(); ++i)
+		is_start[*i] = 1;
+
+	++heuristic_generation;
+	if(heuristic_generation == 0)
+	{
+		std::fill(heuristic_generations.begin(), heuristic_generations.end(), 0);
+		heuristic_generation = 1;
+	}
+	if(is_initialized)
+		update_vertex(virtual_start);
+	return true;
+}
+
+//    ;        find_shortest_path.
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+bool IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::set_goal_group(const std::set<int>& goal_group)
+{
+	if(!is_group_valid(goal_group))
+		return false;
+	for(std::set<int>::const_iterator i=this->goal_group.begin(); i != this->goal_group.end(); ++i)
+		is_goal[*i] = 0;
+	this->goal_group = goal_group;
+	for(std::set<int>::const_iterator i=this->goal_group.begin(); i != this->goal_group.end(); ++i)
+		is_goal[*i] = 1;
+	is_initialized = false;
+	return true;
+}
+
+//       :      ,   .
+//   :      find_shortest_path.
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+bool IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::notify_edge_changed(
+	const int vertex_origin, const int vertex_destination)
+{
+	if(vertex_origin >= num_vertices || vertex_destination >= num_vertices
+		|| vertex_origin < 0 || vertex_destination < 0)
+		return false;
+	if(is_initialized)
+	{
+		update_vertex(vertex_origin);
+		update_vertex(vertex_destination);
+	}
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::initialize()
+{
+	costs.assign(num_vertices + 1, infinite_cost());
+	lookahead_costs.assign(num_vertices + 1, infinite_cost());
+	queue.clear();
+	key_modifier = TEdgeWeight();
+	for(std::set<int>::const_iterator i=goal_group.begin(); i != goal_group.end(); ++i)
+	{
+		Cost zero_cost = { TEdgeWeight(), 0 };
+		lookahead_costs[*i] = zero_cost;
+		queue.push(*i, calculate_key(*i));
+	}
+	update_vertex(virtual_start);
+	is_initialized = true;
+}
+
+//        ;     .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+TEdgeWeight IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::get_heuristic_cost(const int vertex)
+{
+	if(vertex == virtual_start || start_group.empty())
+		return TEdgeWeight();
+	if(heuristic_generations[vertex] != heuristic_generation)
+	{
+		heuristic_generations[vertex] = heuristic_generation;
+		heuristic_costs[vertex] = heuristic.get_min_cost(graph, vertex, start_group);
+	}
+	return heuristic_costs[vertex];
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+typename IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::Key
+	IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::calculate_key(const int vertex)
+{
+	const Cost& cost = lookahead_costs[vertex] < costs[vertex] ? lookahead_costs[vertex] : costs[vertex];
+	Key key;
+	key.secondary = cost.weight;
+	key.primary.weight = add_costs(add_costs(cost.weight, get_heuristic_cost(vertex)), key_modifier);
+	key.primary.num_edges = cost.num_edges;
+	return key;
+}
+
+//  rhs(vertex)           
+//    ,    (g == rhs).
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::update_vertex(const int vertex)
+{
+	if(!is_goal[vertex])
+	{
+		Cost lookahead_cost = infinite_cost();
+		if(vertex == virtual_start)
+		{
+			for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+				if(costs[*i] < lookahead_cost)
+					lookahead_cost = costs[*i];
+		}
+		else
+		{
+			typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors;
+			graph.get_neighbor_range(vertex, neighbors);
+			for(size_t i=0; i < neighbors.size(); ++i)
+			{
+				Cost cost = add_edge(neighbors.weight(i), costs[neighbors.destination(i)]);
+				if(cost < lookahead_cost)
+					lookahead_cost = cost;
+			}
+		}
+		lookahead_costs[vertex] = lookahead_cost;
+	}
+
+	bool is_consistent = costs[vertex] == lookahead_costs[vertex];
+	if(queue.contains(vertex))
+	{
+		if(is_consistent)
+			queue.remove(vertex);
+		else
+			queue.update_key(vertex, calculate_key(vertex));
+	}
+	else if(!is_consistent)
+		queue.push(vertex, calculate_key(vertex));
+}
+
+//  ,    -  ;    
+//    -   .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::update_predecessors(const int vertex)
+{
+	typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors;
+	graph.get_neighbor_range(vertex, neighbors);
+	for(size_t i=0; i < neighbors.size(); ++i)
+		update_vertex(neighbors.destination(i));
+	if(is_start[vertex])
+		update_vertex(virtual_start);
+}
+
+//    ,       
+//          .      :
+//       ,         .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::compute_shortest_path()
+{
+	num_settled = 0;
+	while(!queue.empty() && (!(calculate_key(virtual_start) < queue.top_priority()) ||
+		costs[virtual_start] != lookahead_costs[virtual_start]))
+	{
+		int vertex = queue.top();
+		Key old_key = queue.top_priority();
+		Key new_key = calculate_key(vertex);
+		++num_settled;
+		if(old_key < new_key)
+		{
+			queue.update_key(vertex, new_key);
+		}
+		else if(lookahead_costs[vertex] < costs[vertex])
+		{
+			costs[vertex] = lookahead_costs[vertex];
+			queue.remove(vertex);
+			update_predecessors(vertex);
+		}
+		else
+		{
+			costs[vertex] = infinite_cost();
+			update_vertex(vertex);
+			update_predecessors(vertex);
+		}
+	}
+}
+
+//            ,   AStarSearch::find_shortest_path,
+//    .        ,
+//       w,      g(w) .    
+// (. Cost),  g              .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+bool IncrementalSearch<TVertexValue, TEdgeWeight, THeuristic>::find_shortest_path(
+	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	if(start_group.empty() || goal_group.empty())
+		return false;
+	if(!is_initialized)
+		initialize();
+	compute_shortest_path();
+	if(lookahead_costs[virtual_start].weight == infinity())
+		return false;
+
+	int current_vertex = -1;
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+		if(current_vertex == -1 || costs[*i] < costs[current_vertex])
+			current_vertex = *i;
+
+	shortest_path.clear();
+	shortest_path.push_back(current_vertex);
+	typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors;
+	while(!is_goal[current_vertex])
+	{
+		//  g    ,       ;  
+		//  ,      .
+		if(shortest_path.size() > static_cast<size_t>(num_vertices))
+			return false;
+		graph.get_neighbor_range(current_vertex, neighbors);
+		int next_vertex = -1;
+		Cost next_cost = infinite_cost();
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			Cost cost = add_edge(neighbors.weight(i), costs[neighbors.destination(i)]);
+			if(cost < next_cost)
+			{
+				next_cost = cost;
+				next_vertex = neighbors.destination(i);
+			}
+		}
+		if(next_vertex == -1)
+			return false;
+		shortest_path.push_back(next_vertex);
+		current_vertex = next_vertex;
+	}
+	shortest_path_cost = costs[virtual_start].weight;
+	return true;
+}
+#endif
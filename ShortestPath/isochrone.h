@@ -0,0 +1,85 @@
+#pragma once
+#ifndef ISOCHRONE_H
+#define ISOCHRONE_H
+
+#include <algorithm>
+#include <vector>
+
+// ,    :  origin (   )    
+//  remaining_cost   .  destination  ,     .
+template<typename TEdgeWeight>
+struct IsochroneEdge
+{
+	int origin;
+	int destination;
+	TEdgeWeight remaining_cost;
+
+	IsochroneEdge() : origin(-1), destination(-1), remaining_cost(TEdgeWeight()) {}
+	IsochroneEdge(int origin, int destination, const TEdgeWeight& remaining_cost)
+		: origin(origin), destination(destination), remaining_cost(remaining_cost) {}
+};
+
+//   ,      (. AStarSearch::find_reachable).
+//    .        
+//         (-1  ),  
+//    k -  get_num_vertices(k) ,      .
+//      ,    .
+template<typename TEdgeWeight>
+class Isochrone
+{
+	std::vector<TEdgeWeight> budgets;
+	std::vector<int> vertices;
+	std::vector<int> parents;
+	std::vector<TEdgeWeight> costs;
+	std::vector<std::vector<IsochroneEdge<TEdgeWeight>>> frontiers;
+public:
+	Isochrone() { }
+	void reset(const std::vector<TEdgeWeight>& budgets);
+	int get_num_budgets() const { return static_cast<int>(budgets.size()); }
+	const TEdgeWeight& get_budget(int budget_index) const { return budgets[budget_index]; }
+	size_t get_num_vertices() const { return vertices.size(); }
+	size_t get_num_vertices(int budget_index) const;
+	int get_vertex(size_t index) const { return vertices[index]; }
+	int get_parent(size_t index) const { return parents[index]; }
+	const TEdgeWeight& get_cost(size_t index) const { return costs[index]; }
+	const std::vector<IsochroneEdge<TEdgeWeight>>& get_frontier(int budget_index) const { return frontiers[budget_index]; }
+	void add_vertex(int vertex, int parent, const TEdgeWeight& cost);
+	void add_frontier_edge(int budget_index, int origin, int destination, const TEdgeWeight& remaining_cost);
+};
+
+//  ;  ,  .
+template<typename TEdgeWeight>
+void Isochrone<TEdgeWeight>::reset(const std::vector<TEdgeWeight>& budgets)
+{
+	this->budgets = budgets;
+	std::sort(this->budgets.begin(), this->budgets.end());
+	this->budgets.erase(std::unique(this->budgets.begin(), this->budgets.end()), this->budgets.end());
+	vertices.clear();
+	parents.clear();
+	costs.clear();
+	frontiers.assign(this->budgets.size(), std::vector<IsochroneEdge<TEdgeWeight>>());
+}
+
+//        budget_index.
+template<typename TEdgeWeight>
+size_t Isochrone<TEdgeWeight>::get_num_vertices(int budget_index) const
+{
+	return static_cast<size_t>(std::upper_bound(costs.begin(), costs.end(), budgets[budget_index]) - costs.begin());
+}
+
+//      .
+template<typename TEdgeWeight>
+inline void Isochrone<TEdgeWeight>::add_vertex(int vertex, int parent, const TEdgeWeight& cost)
+{
+	vertices.push_back(vertex);
+	parents.push_back(parent);
+	costs.push_back(cost);
+}
+
+template<typename TEdgeWeight>
+inline void Isochrone<TEdgeWeight>::add_frontier_edge(int budget_index, int origin, int destination,
+	const TEdgeWeight& remaining_cost)
+{
+	frontiers[budget_index].push_back(IsochroneEdge<TEdgeWeight>(origin, destination, remaining_cost));
+}
+#endif
@@ -0,0 +1,473 @@
+#pragma once
+#ifndef JPS_H
+#define JPS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <set>
+#include <vector>
+#include "gridgraph.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//    (Jump Point Search)   GridGraph.
+//             ,
+//    ,  A*     . JPS 
+//    - ,      :    
+//      (jump_straight, jump_diagonal),    ,
+//      <<>>  - ,         .
+//        ,    (add_directions).
+//    GridGraph:       .
+//        AStarSearch    GridGraph   ,
+//   .      ,   AStarSearch.
+//       (. SearchContext),        .
+class JumpPointSearch
+{
+public:
+	class SearchContext;
+	template<typename THeuristic>
+	static bool find_shortest_path(
+		const GridGraph& grid, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, std::list<int>& shortest_path, double& shortest_path_cost);
+	template<typename THeuristic>
+	static bool find_shortest_path(
+		const GridGraph& grid, const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, SearchContext& context,
+		std::list<int>& shortest_path, double& shortest_path_cost);
+private:
+	struct JumpPointStatus;
+	class GoalArea;
+	static int jump_straight(const GridGraph& grid, const GoalArea& goals, int x, int y, const int dx, const int dy);
+	static int jump_diagonal(const GridGraph& grid, const GoalArea& goals, int x, int y, const int dx, const int dy);
+	static int add_directions(const GridGraph& grid, const int x, const int y, const int dx, const int dy,
+		int directions[8][2]);
+	static double get_octile_distance(const int dx, const int dy);
+	static std::uint64_t get_blocked_cells(const GridGraph& grid, const bool is_vertical, const int line, const int first);
+	static int find_first_cell(const std::uint64_t cells, const int step);
+};
+
+struct JumpPointSearch::JumpPointStatus
+{
+	int vertex;
+	int parent;
+	bool is_closed;
+	double cost_from_start_to_this;
+	double heuristic_cost_from_this_to_goal;
+
+	JumpPointStatus(int vertex) : vertex(vertex), parent(-1), is_closed(false),
+		cost_from_start_to_this(0.0), heuristic_cost_from_this_to_goal(0.0) {}
+};
+
+//   ,     .
+//      ;       .
+//         -      
+// (slots -   , -1 -  ),     .
+//        ,   .
+//        .
+class JumpPointSearch::SearchContext
+{
+	friend class JumpPointSearch;
+
+	std::vector<int> slots;
+	int capacity_bits;
+	std::vector<JumpPointStatus> jump_points;
+	IndexedPriorityQueue<double> open_vertices_queue;
+	size_t num_settled;
+
+	size_t find_slot(const int vertex) const;
+	void grow();
+	void reset();
+	int get_index(const int vertex, bool& is_new);
+public:
+	SearchContext() : capacity_bits(0), num_settled(0) { }
+	//   ,      .
+	size_t get_num_settled() const { return num_settled; }
+};
+
+//      .    ,  ,
+//           .
+class JumpPointSearch::GoalArea
+{
+	const std::set<int>& goal_group;
+	int width;
+	int min_x, min_y, max_x, max_y;
+public:
+	GoalArea(const GridGraph& grid, const std::set<int>& goal_group);
+	bool contains(const int x, const int y) const;
+	bool intersects(const bool is_vertical, const int line, const int first, const int last) const;
+};
+
+//          ,   .
+inline size_t JumpPointSearch::SearchContext::find_slot(const int vertex) const
+{
+	const size_t mask = slots.size() - 1;
+	size_t current = static_cast<size_t>((static_cast<std::uint64_t>(static_cast<std::uint32_t>(vertex))*
+		0x9E3779B97F4A7C15ULL) >> (64 - capacity_bits));
+	while(slots[current] != -1 && jump_points[slots[current]].vertex != vertex)
+		current = (current + 1) & mask;
+	return current;
+}
+
+inline void JumpPointSearch::SearchContext::grow()
+{
+	capacity_bits = capacity_bits == 0 ? 10 : capacity_bits + 1;
+	slots.assign(static_cast<size_t>(1) << capacity_bits, -1);
+	for(size_t i=0; i < jump_points.size(); ++i)
+		slots[find_slot(jump_points[i].vertex)] = static_cast<int>(i);
+}
+
+//    ,  :      
+//  ,  ,        .
+inline void JumpPointSearch::SearchContext::reset()
+{
+	for(size_t i=jump_points.size(); i > 0; --i)
+		slots[find_slot(jump_points[i - 1].vertex)] = -1;
+	jump_points.clear();
+	open_vertices_queue.clear();
+	num_settled = 0;
+}
+
+//    ,         .
+inline int JumpPointSearch::SearchContext::get_index(const int vertex, bool& is_new)
+{
+	if(2*(jump_points.size() + 1) > slots.size())
+		grow();
+	size_t slot = find_slot(vertex);
+	is_new = slots[slot] == -1;
+	if(is_new)
+	{
+		slots[slot] = static_cast<int>(jump_points.size());
+		jump_points.push_back(JumpPointStatus(vertex));
+		open_vertices_queue.resize(jump_points.capacity());
+	}
+	return slots[slot];
+}
+
+// ,     .
+inline JumpPointSearch::GoalArea::GoalArea(const GridGraph& grid, const std::set<int>& goal_group)
+	: goal_group(goal_group), width(grid.get_width()), min_x(0), min_y(0), max_x(-1), max_y(-1)
+{
+	for(std::set<int>::const_iterator i=goal_group.begin(); i != goal_group.end(); ++i)
+	{
+		int x = *i % width;
+		int y = *i / width;
+		if(i == goal_group.begin() || x < min_x)
+			min_x = x;
+		if(i == goal_group.begin() || y < min_y)
+			min_y = y;
+		if(i == goal_group.begin() || x > max_x)
+			max_x = x;
+		if(i == goal_group.begin() || y > max_y)
+			max_y = y;
+	}
+}
+
+inline bool JumpPointSearch::GoalArea::contains(const int x, const int y) const
+{
+	if(x < min_x || x > max_x || y < min_y || y > max_y)
+		return false;
+	return goal_group.count(y*width + x) != 0;
+}
+
+//         first   last (  ).
+inline bool JumpPointSearch::GoalArea::intersects(const bool is_vertical, const int line,
+	const int first, const int last) const
+{
+	int line_min = is_vertical ? min_x : min_y;
+	int line_max = is_vertical ? max_x : max_y;
+	int position_min = is_vertical ? min_y : min_x;
+	int position_max = is_vertical ? max_y : max_x;
+	return line >= line_min && line <= line_max &&
+		std::max(first, last) >= position_min && std::min(first, last) <= position_max;
+}
+
+//   64   line,    first ( is_vertical - ).
+inline std::uint64_t JumpPointSearch::get_blocked_cells(const GridGraph& grid, const bool is_vertical,
+	const int line, const int first)
+{
+	return is_vertical ? grid.get_blocked_column(line, first) : grid.get_blocked_row(first, line);
+}
+
+//        :  step > 0 -   ,   .
+//  64,    .
+inline int JumpPointSearch::find_first_cell(const std::uint64_t cells, const int step)
+{
+	if(cells == 0)
+		return 64;
+#ifdef _MSC_VER
+	// 64-  _BitScan*    Win32,     .
+	const unsigned long low = static_cast<unsigned long>(cells), high = static_cast<unsigned long>(cells >> 32);
+	unsigned long index;
+	if(step > 0)
+	{
+		if(_BitScanForward(&index, low))
+			return static_cast<int>(index);
+		_BitScanForward(&index, high);
+		return static_cast<int>(index) + 32;
+	}
+	if(_BitScanReverse(&index, high))
+		return 31 - static_cast<int>(index);
+	_BitScanReverse(&index, low);
+	return 63 - static_cast<int>(index);
+#else
+	return step > 0 ? __builtin_ctzll(cells) : __builtin_clzll(cells);
+#endif
+}
+
+//      ,   dx  dy.
+inline double JumpPointSearch::get_octile_distance(const int dx, const int dy)
+{
+	int straight = std::max(std::abs(dx), std::abs(dy));
+	int diagonal = std::min(std::abs(dx), std::abs(dy));
+	return (straight - diagonal) + diagonal*GridGraph::DIAGONAL_COST;
+}
+
+//     (x, y)   (dx, dy),     .
+//        -1,        .
+//  -  ,          ,     - :
+//          .
+//     64 :       
+//     () ,     
+//   ,      .
+inline int JumpPointSearch::jump_straight(const GridGraph& grid, const GoalArea& goals,
+	int x, int y, const int dx, const int dy)
+{
+	//    (position)   (line);      .
+	const bool is_vertical = dx == 0;
+	const int step = is_vertical ? dy : dx;
+	const int line = is_vertical ? x : y;
+	int position = is_vertical ? y : x;
+	while(true)
+	{
+		//  j    first + j;    i    - position + step*(i + 1).
+		int first = step > 0 ? position + 1 : position - 64;
+		std::uint64_t blocked = get_blocked_cells(grid, is_vertical, line, first);
+		std::uint64_t forced = 0;
+		for(int side=-1; side <= 1; side += 2)
+			forced |= ~get_blocked_cells(grid, is_vertical, line + side, first) &
+				get_blocked_cells(grid, is_vertical, line + side, first - step);
+
+		int first_blocked = find_first_cell(blocked, step);
+		int first_forced = find_first_cell(forced, step);
+		int last = std::min(first_blocked, first_forced);
+		if(goals.intersects(is_vertical, line, position + step, position + step*std::min(last + 1, 64)))
+			for(int i=0; i < last; ++i)
+			{
+				int cell = position + step*(i + 1);
+				if(is_vertical ? goals.contains(line, cell) : goals.contains(cell, line))
+					return is_vertical ? grid.get_vertex(line, cell) : grid.get_vertex(cell, line);
+			}
+		if(first_forced < first_blocked)
+		{
+			int cell = position + step*(first_forced + 1);
+			return is_vertical ? grid.get_vertex(line, cell) : grid.get_vertex(cell, line);
+		}
+		if(first_blocked < 64)
+			return -1;
+		position += 64*step;
+	}
+}
+
+//     (x, y)   (dx, dy).   -  ,   
+//                 .
+inline int JumpPointSearch::jump_diagonal(const GridGraph& grid, const GoalArea& goals,
+	int x, int y, const int dx, const int dy)
+{
+	while(true)
+	{
+		if(!grid.is_free(x + dx, y) || !grid.is_free(x, y + dy))
+			return -1;
+		x += dx;
+		y += dy;
+		if(!grid.is_free(x, y))
+			return -1;
+		if(goals.contains(x, y) ||
+			jump_straight(grid, goals, x, y, dx, 0) != -1 || jump_straight(grid, goals, x, y, 0, dy) != -1)
+			return grid.get_vertex(x, y);
+	}
+}
+
+//   directions ,        (x, y),
+//       (dx, dy);    (dx = dy = 0) -   .
+//   .
+//          .     - ,
+//     -:      -   .
+//     .
+inline int JumpPointSearch::add_directions(const GridGraph& grid, const int x, const int y, const int dx, const int dy,
+	int directions[8][2])
+{
+	int num_directions = 0;
+	if(dx == 0 && dy == 0)
+	{
+		for(int i=-1; i <= 1; ++i)
+			for(int j=-1; j <= 1; ++j)
+				if(i != 0 || j != 0)
+				{
+					directions[num_directions][0] = i;
+					directions[num_directions][1] = j;
+					++num_directions;
+				}
+		return num_directions;
+	}
+
+	directions[num_directions][0] = dx;
+	directions[num_directions][1] = dy;
+	++num_directions;
+	if(dx != 0 && dy != 0)
+	{
+		int components[2][2] = { { dx, 0 }, { 0, dy } };
+		for(int i=0; i < 2; ++i)
+		{
+			directions[num_directions][0] = components[i][0];
+			directions[num_directions][1] = components[i][1];
+			++num_directions;
+		}
+		return num_directions;
+	}
+
+	//  : (dy, dx)  (-dy, -dx)  (dx, dy).
+	for(int side=-1; side <= 1; side += 2)
+	{
+		int side_x = side*dy;
+		int side_y = side*dx;
+		if(!grid.is_free(x + side_x, y + side_y))
+			continue;
+		directions[num_directions][0] = side_x;
+		directions[num_directions][1] = side_y;
+		++num_directions;
+		directions[num_directions][0] = dx + side_x;
+		directions[num_directions][1] = dy + side_y;
+		++num_directions;
+	}
+	return num_directions;
+}
+
+//         ;    
+//   SearchContext.
+template<typename THeuristic>
+bool JumpPointSearch::find_shortest_path(
+	const GridGraph& grid, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, std::list<int>& shortest_path, double& shortest_path_cost)
+{
+	SearchContext context;
+	return find_shortest_path(grid, start_group, goal_group, heuristic, context, shortest_path, shortest_path_cost);
+}
+
+//  A*    :    -    ,
+//   -  .      .
+//  false,            .
+template<typename THeuristic>
+bool JumpPointSearch::find_shortest_path(
+	const GridGraph& grid, const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, SearchContext& context,
+	std::list<int>& shortest_path, double& shortest_path_cost)
+{
+	if(start_group.empty() || goal_group.empty())
+		return false;
+
+	const int width = grid.get_width();
+	for(std::set<int>::const_iterator i=goal_group.begin(); i != goal_group.end(); ++i)
+		if(*i >= grid.get_num_vertices() || *i < 0 || !grid.is_free(*i % width, *i / width))
+			return false;
+
+	context.reset();
+	GoalArea goals(grid, goal_group);
+	const std::set<int>& heuristic_goal_group = get_heuristic_group(heuristic, goal_group);
+	IndexedPriorityQueue<double>& open_vertices_queue = context.open_vertices_queue;
+	bool is_new;
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+	{
+		if(*i >= grid.get_num_vertices() || *i < 0 || !grid.is_free(*i % width, *i / width))
+			return false;
+		int index = context.get_index(*i, is_new);
+		JumpPointStatus& start_status = context.jump_points[index];
+		if constexpr(!IsZeroHeuristic<THeuristic>::value)
+			start_status.heuristic_cost_from_this_to_goal = heuristic.get_min_cost(grid, *i, heuristic_goal_group);
+		open_vertices_queue.push(index, start_status.heuristic_cost_from_this_to_goal);
+	}
+
+	int directions[8][2];
+	while(!open_vertices_queue.empty())
+	{
+		int index = open_vertices_queue.top();
+		open_vertices_queue.pop();
+		++context.num_settled;
+		context.jump_points[index].is_closed = true;
+
+		//     :      .
+		const int vertex = context.jump_points[index].vertex;
+		const double cost_from_start_to_this = context.jump_points[index].cost_from_start_to_this;
+		const int x = vertex % width;
+		const int y = vertex / width;
+		if(goals.contains(x, y))
+		{
+			shortest_path_cost = cost_from_start_to_this;
+			shortest_path.clear();
+			shortest_path.push_front(vertex);
+			for(int current=index; context.jump_points[current].parent != -1; current=context.jump_points[current].parent)
+			{
+				//        .
+				int current_x = context.jump_points[current].vertex % width;
+				int current_y = context.jump_points[current].vertex / width;
+				int parent_vertex = context.jump_points[context.jump_points[current].parent].vertex;
+				int parent_x = parent_vertex % width;
+				int parent_y = parent_vertex / width;
+				int step_x = parent_x > current_x ? 1 : (parent_x < current_x ? -1 : 0);
+				int step_y = parent_y > current_y ? 1 : (parent_y < current_y ? -1 : 0);
+				while(current_x != parent_x || current_y != parent_y)
+				{
+					current_x += step_x;
+					current_y += step_y;
+					shortest_path.push_front(grid.get_vertex(current_x, current_y));
+				}
+			}
+			return true;
+		}
+
+		int dx = 0, dy = 0;
+		if(context.jump_points[index].parent != -1)
+		{
+			int parent_vertex = context.jump_points[context.jump_points[index].parent].vertex;
+			int parent_x = parent_vertex % width;
+			int parent_y = parent_vertex / width;
+			dx = x > parent_x ? 1 : (x < parent_x ? -1 : 0);
+			dy = y > parent_y ? 1 : (y < parent_y ? -1 : 0);
+		}
+
+		int num_directions = add_directions(grid, x, y, dx, dy, directions);
+		for(int i=0; i < num_directions; ++i)
+		{
+			int jump_point = directions[i][0] != 0 && directions[i][1] != 0 ?
+				jump_diagonal(grid, goals, x, y, directions[i][0], directions[i][1]) :
+				jump_straight(grid, goals, x, y, directions[i][0], directions[i][1]);
+			if(jump_point == -1)
+				continue;
+
+			double cost_from_start_to_jump_point = cost_from_start_to_this +
+				get_octile_distance(jump_point % width - x, jump_point / width - y);
+			int jump_index = context.get_index(jump_point, is_new);
+			JumpPointStatus& jump_status = context.jump_points[jump_index];
+			if(jump_status.is_closed ||
+				(!is_new && cost_from_start_to_jump_point >= jump_status.cost_from_start_to_this))
+				continue;
+
+			if(is_new)
+			{
+				if constexpr(!IsZeroHeuristic<THeuristic>::value)
+					jump_status.heuristic_cost_from_this_to_goal = heuristic.get_min_cost(grid, jump_point, heuristic_goal_group);
+			}
+			jump_status.parent = index;
+			jump_status.cost_from_start_to_this = cost_from_start_to_jump_point;
+			double priority = cost_from_start_to_jump_point + jump_status.heuristic_cost_from_this_to_goal;
+			if(is_new)
+				open_vertices_queue.push(jump_index, priority);
+			else
+				open_vertices_queue.decrease_key(jump_index, priority);
+		}
+	}
+
+	return false;
+}
+#endif
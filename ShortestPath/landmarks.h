@@ -0,0 +1,326 @@
+#pragma once
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <istream>
+#include <ostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "graphio.h"
+
+//   ALT (A*, landmarks, triangle inequality).
+//       (landmarks)       
+//               (   
+//  ).        l  d(v,g)  
+// d(l,g) - d(l,v)  d(v,l) - d(g,l);        
+//       ,       
+// (,   ),     .    ,
+//     |d(l,v) - d(l,g)|.
+//        ,       .
+template<typename TVertexValue, typename TEdgeWeight>
+class AStarLandmarkHeuristic : public AStarHeuristic<AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>, TEdgeWeight>
+{
+public:
+	// FARTHEST -         .
+	// AVOID -         ,     .
+	enum SelectionMethod { FARTHEST, AVOID };
+
+	AStarLandmarkHeuristic();
+	template<typename TGraph>
+	AStarLandmarkHeuristic(const TGraph& graph, int num_landmarks, SelectionMethod method = AVOID);
+	template<typename TGraph>
+	TEdgeWeight get_cost(const TGraph& graph, int start, int goal) const;
+	TEdgeWeight get_lower_bound(const int vertex, const int goal) const;
+	const std::vector<int>& get_landmarks() const;
+	void save(std::ostream& out_stream) const;
+	template<typename TGraph>
+	void load(const TGraph& graph, std::istream& in_stream);
+
+private:
+	std::vector<int> landmarks;
+	//     l   v   distances[2*v*landmarks.size() + l],
+	//   v  l -  distances[(2*v + 1)*landmarks.size() + l],   ,   
+	//  ,    .
+	std::vector<TEdgeWeight> distances;
+	int num_vertices;
+
+	static TEdgeWeight unreachable() { return std::numeric_limits<TEdgeWeight>::max(); }
+	template<typename TGraph>
+	static void find_distances(const TGraph& graph, const std::vector<int>& sources, const bool is_reversed,
+		std::vector<TEdgeWeight>& costs, std::vector<int>& parents, std::vector<int>& settle_order);
+	template<typename TGraph>
+	int select_farthest(const TGraph& graph) const;
+	template<typename TGraph>
+	int select_avoid(const TGraph& graph, const int root) const;
+	void add_landmark(const int landmark, const std::vector<TEdgeWeight>& costs, const std::vector<TEdgeWeight>& reversed_costs);
+};
+
+template<typename TVertexValue, typename TEdgeWeight>
+AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::AStarLandmarkHeuristic() : num_vertices(0) { }
+
+//  num_landmarks        .
+//    -     ;   
+//   ,   .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::AStarLandmarkHeuristic(
+	const TGraph& graph, int num_landmarks, SelectionMethod method)
+	: num_vertices(graph.get_num_vertices())
+{
+	if(num_vertices == 0)
+		return;
+	if(num_landmarks > num_vertices)
+		num_landmarks = num_vertices;
+
+	std::mt19937 generator(0);
+	std::uniform_int_distribution<int> random_vertex(0, num_vertices - 1);
+	std::vector<TEdgeWeight> costs, reversed_costs;
+	std::vector<int> parents, settle_order;
+
+	std::vector<int> sources(1, random_vertex(generator));
+	find_distances(graph, sources, false, costs, parents, settle_order);
+	int landmark = settle_order.size() < static_cast<size_t>(num_vertices) ? -1 : settle_order.back();
+	if(landmark == -1)
+		landmark = select_farthest(graph);
+
+	while(landmark != -1 && static_cast<int>(landmarks.size()) < num_landmarks)
+	{
+		sources.assign(1, landmark);
+		find_distances(graph, sources, true, reversed_costs, parents, settle_order);
+		find_distances(graph, sources, false, costs, parents, settle_order);
+		add_landmark(landmark, costs, reversed_costs);
+		if(static_cast<int>(landmarks.size()) == num_landmarks)
+			break;
+		landmark = method == FARTHEST ? select_farthest(graph) : select_avoid(graph, random_vertex(generator));
+	}
+}
+
+//      sources    ,   is_reversed -   
+//   (            ).
+//     costs  unreachable(),  settle_order -     .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+void AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::find_distances(const TGraph& graph, const std::vector<int>& sources,
+	const bool is_reversed, std::vector<TEdgeWeight>& costs, std::vector<int>& parents, std::vector<int>& settle_order)
+{
+	const int num_vertices = graph.get_num_vertices();
+	costs.assign(num_vertices, unreachable());
+	parents.assign(num_vertices, -1);
+	settle_order.clear();
+
+	IndexedPriorityQueue<TEdgeWeight> queue(num_vertices);
+	for(size_t i=0; i < sources.size(); ++i)
+		if(!queue.contains(sources[i]))
+		{
+			costs[sources[i]] = TEdgeWeight();
+			queue.push(sources[i], TEdgeWeight());
+		}
+
+	typename TGraph::NeighborRange neighbors;
+	while(!queue.empty())
+	{
+		int vertex = queue.top();
+		queue.pop();
+		settle_order.push_back(vertex);
+
+		graph.get_neighbor_range(vertex, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			int neighbor = neighbors.destination(i);
+			TEdgeWeight weight = is_reversed ? neighbors.reverse_weight(i) : neighbors.weight(i);
+			TEdgeWeight cost = costs[vertex] + weight;
+			if(costs[neighbor] == unreachable())
+			{
+				costs[neighbor] = cost;
+				parents[neighbor] = vertex;
+				queue.push(neighbor, cost);
+			}
+			else if(cost < costs[neighbor] && queue.contains(neighbor))
+			{
+				costs[neighbor] = cost;
+				parents[neighbor] = vertex;
+				queue.decrease_key(neighbor, cost);
+			}
+		}
+	}
+}
+
+//   ,       .
+// costs -    , reversed_costs -  .
+template<typename TVertexValue, typename TEdgeWeight>
+void AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::add_landmark(const int landmark,
+	const std::vector<TEdgeWeight>& costs, const std::vector<TEdgeWeight>& reversed_costs)
+{
+	size_t old_count = landmarks.size();
+	size_t new_count = old_count + 1;
+	std::vector<TEdgeWeight> new_distances(2*static_cast<size_t>(num_vertices)*new_count);
+	for(size_t row=0; row < 2*static_cast<size_t>(num_vertices); ++row)
+	{
+		for(size_t l=0; l < old_count; ++l)
+			new_distances[row*new_count + l] = distances[row*old_count + l];
+		new_distances[row*new_count + old_count] = row % 2 == 0 ? costs[row/2] : reversed_costs[row/2];
+	}
+	distances.swap(new_distances);
+	landmarks.push_back(landmark);
+}
+
+// ,        .
+//               .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+int AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::select_farthest(const TGraph& graph) const
+{
+	std::vector<TEdgeWeight> costs;
+	std::vector<int> parents, settle_order;
+	find_distances(graph, landmarks, false, costs, parents, settle_order);
+
+	int farthest = -1;
+	for(int v=0; v < num_vertices; ++v)
+		if(costs[v] == unreachable())
+			return v;
+		else if(farthest == -1 || costs[farthest] < costs[v])
+			farthest = v;
+	return costs[farthest] == TEdgeWeight() ? -1 : farthest;
+}
+
+//  avoid:      root,   -    d(root,v) - h(root,v).
+//   -    ,  ,       .
+//   root     ,  ,      .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+int AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::select_avoid(const TGraph& graph, const int root) const
+{
+	std::vector<TEdgeWeight> costs;
+	std::vector<int> parents, settle_order;
+	find_distances(graph, std::vector<int>(1, root), false, costs, parents, settle_order);
+	if(settle_order.size() < static_cast<size_t>(num_vertices))
+		return select_farthest(graph);
+
+	std::vector<TEdgeWeight> sizes(num_vertices);
+	std::vector<bool> has_landmark(num_vertices, false);
+	for(size_t i=0; i < landmarks.size(); ++i)
+		has_landmark[landmarks[i]] = true;
+	for(int v=0; v < num_vertices; ++v)
+		sizes[v] = costs[v] - get_lower_bound(root, v);
+
+	for(size_t i=settle_order.size(); i-- > 1; )
+	{
+		int vertex = settle_order[i];
+		int parent = parents[vertex];
+		if(has_landmark[vertex])
+			has_landmark[parent] = true;
+		else
+			sizes[parent] = sizes[parent] + sizes[vertex];
+	}
+
+	std::vector<int> best_child(num_vertices, -1);
+	for(size_t i=1; i < settle_order.size(); ++i)
+	{
+		int vertex = settle_order[i];
+		int parent = parents[vertex];
+		if(has_landmark[vertex])
+			continue;
+		if(best_child[parent] == -1 || sizes[best_child[parent]] < sizes[vertex])
+			best_child[parent] = vertex;
+	}
+
+	if(has_landmark[root] && best_child[root] == -1)
+		return select_farthest(graph);
+	int leaf = root;
+	while(best_child[leaf] != -1)
+		leaf = best_child[leaf];
+	for(size_t i=0; i < landmarks.size(); ++i)
+		if(landmarks[i] == leaf)
+			return select_farthest(graph);
+	return leaf;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+TEdgeWeight AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::get_cost(const TGraph&, int start, int goal) const
+{
+	return get_lower_bound(start, goal);
+}
+
+//     vertex  goal:  d(l,goal) - d(l,vertex)  d(vertex,l) - d(goal,l)
+//    .   ,      .
+template<typename TVertexValue, typename TEdgeWeight>
+TEdgeWeight AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::get_lower_bound(const int vertex, const int goal) const
+{
+	TEdgeWeight bound = TEdgeWeight();
+	if(landmarks.empty() || vertex >= num_vertices || goal >= num_vertices || vertex < 0 || goal < 0)
+		return bound;
+
+	size_t num_landmarks = landmarks.size();
+	const TEdgeWeight* vertex_distances = &distances[0] + 2*static_cast<size_t>(vertex)*num_landmarks;
+	const TEdgeWeight* goal_distances = &distances[0] + 2*static_cast<size_t>(goal)*num_landmarks;
+	for(size_t l=0; l < num_landmarks; ++l)
+	{
+		if(vertex_distances[l] < goal_distances[l] && goal_distances[l] != unreachable() &&
+			bound < goal_distances[l] - vertex_distances[l])
+			bound = goal_distances[l] - vertex_distances[l];
+		const TEdgeWeight& vertex_to_landmark = vertex_distances[num_landmarks + l];
+		const TEdgeWeight& goal_to_landmark = goal_distances[num_landmarks + l];
+		if(goal_to_landmark < vertex_to_landmark && vertex_to_landmark != unreachable() &&
+			bound < vertex_to_landmark - goal_to_landmark)
+			bound = vertex_to_landmark - goal_to_landmark;
+	}
+	return bound;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+const std::vector<int>& AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::get_landmarks() const
+{
+	return landmarks;
+}
+
+//   : ,   ,  ,   ,
+//           .
+//         TEdgeWeight.
+template<typename TVertexValue, typename TEdgeWeight>
+void AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::save(std::ostream& out_stream) const
+{
+	const char signature[4] = { 'A', 'L', 'T', '1' };
+	int header[3] = { static_cast<int>(sizeof(TEdgeWeight)), num_vertices, static_cast<int>(landmarks.size()) };
+	out_stream.write(signature, sizeof(signature));
+	out_stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+	if(!landmarks.empty())
+	{
+		out_stream.write(reinterpret_cast<const char*>(&landmarks[0]), landmarks.size()*sizeof(int));
+		out_stream.write(reinterpret_cast<const char*>(&distances[0]), distances.size()*sizeof(TEdgeWeight));
+	}
+	if(!out_stream)
+		throw std::ios_base::failure(IOEXCEPTION);
+}
+
+//  ,    graph;   ,    
+//       .
+template<typename TVertexValue, typename TEdgeWeight>
+template<typename TGraph>
+void AStarLandmarkHeuristic<TVertexValue, TEdgeWeight>::load(const TGraph& graph, std::istream& in_stream)
+{
+	char signature[4];
+	int header[3];
+	if(!in_stream.read(signature, sizeof(signature)) || !in_stream.read(reinterpret_cast<char*>(header), sizeof(header)))
+		throw std::ios_base::failure(IOEXCEPTION);
+	if(signature[0] != 'A' || signature[1] != 'L' || signature[2] != 'T' || signature[3] != '1' ||
+		header[0] != static_cast<int>(sizeof(TEdgeWeight)) || header[1] != graph.get_num_vertices() ||
+		header[2] < 0 || header[2] > header[1])
+		throw std::ios_base::failure(IOEXCEPTION);
+
+	std::vector<int> new_landmarks(header[2]);
+	std::vector<TEdgeWeight> new_distances(2*static_cast<size_t>(header[1])*header[2]);
+	if(!new_landmarks.empty() &&
+		(!in_stream.read(reinterpret_cast<char*>(&new_landmarks[0]), new_landmarks.size()*sizeof(int)) ||
+		 !in_stream.read(reinterpret_cast<char*>(&new_distances[0]), new_distances.size()*sizeof(TEdgeWeight))))
+		throw std::ios_base::failure(IOEXCEPTION);
+	for(size_t i=0; i < new_landmarks.size(); ++i)
+		if(new_landmarks[i] < 0 || new_landmarks[i] >= header[1])
+			throw std::ios_base::failure(IOEXCEPTION);
+
+	num_vertices = header[1];
+	landmarks.swap(new_landmarks);
+	distances.swap(new_distances);
+}
+#endif
@@ -0,0 +1,384 @@
+#pragma once
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "astar.h"
+
+//        ,   .
+//    ,      (LRU):
+// -   (     ),  -   ;
+// -          ,  -  ;
+//           .
+//    std::set,    ,        .
+//   (AStarSearch::find_reachable   ),     
+//  tree_threshold ,     (0 -    add_shortest_path_tree),
+//        max_memory.
+//      (. Graph::get_version):      
+//    .      ,    .
+//      ;       SearchContext.
+//    ,          .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph = Graph<TVertexValue, TEdgeWeight>>
+class ShortestPathCache
+{
+	typedef AStarSearch<TVertexValue, TEdgeWeight> Search;
+
+	//   , ,   ;   -    TREE_SEPARATOR.
+	typedef std::vector<int> Key;
+	// UNREACHED -       .
+	enum Marker { PATH_SEPARATOR = -1, TREE_SEPARATOR = -2, UNREACHED = -2 };
+	//    :    -.
+	static const size_t ENTRY_OVERHEAD = 96;
+	//    ,    ;    .
+	static const size_t MAX_COUNTED_GROUPS = 65536;
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Entry
+	{
+		Key key;
+		bool is_found;
+		TEdgeWeight cost;
+		std::vector<int> path;
+		std::vector<TEdgeWeight> tree_costs;
+		std::vector<int> tree_parents;
+		size_t memory;
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	const TGraph& graph;
+	size_t max_memory;
+	size_t tree_threshold;
+	mutable std::mutex cache_mutex;
+	EntryList entries;
+	std::unordered_map<Key, typename EntryList::iterator, KeyHash> entries_index;
+	std::unordered_map<Key, size_t, KeyHash> tree_misses;
+	std::uint64_t version;
+	size_t memory;
+	size_t num_hits;
+	size_t num_tree_hits;
+	size_t num_misses;
+
+	ShortestPathCache(const ShortestPathCache&);
+	ShortestPathCache& operator=(const ShortestPathCache&);
+	static Key make_key(const std::set<int>& start_group, const std::set<int>* goal_group);
+	static bool find_in_tree(const Entry& tree, const std::set<int>& goal_group,
+		std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	size_t get_tree_memory() const;
+	bool build_tree(const std::set<int>& start_group, typename Search::SearchContext& context, Entry& tree) const;
+	void synchronize(std::uint64_t graph_version);
+	void touch(typename EntryList::iterator entry);
+	void insert(Entry& entry, std::uint64_t graph_version);
+	void clear_entries();
+public:
+	ShortestPathCache(const TGraph& graph, size_t max_memory, size_t tree_threshold = 0);
+	template<typename THeuristic>
+	bool find_shortest_path(const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	template<typename THeuristic>
+	bool find_shortest_path(const std::set<int>& start_group, const std::set<int>& goal_group,
+		const THeuristic& heuristic, typename Search::SearchContext& context,
+		std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost);
+	bool add_shortest_path_tree(const std::set<int>& start_group, typename Search::SearchContext& context);
+	void clear();
+	size_t get_memory_usage() const;
+	size_t get_num_entries() const;
+	//  ,      ,    .
+	size_t get_num_hits() const;
+	size_t get_num_tree_hits() const;
+	size_t get_num_misses() const;
+};
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+size_t ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::KeyHash::operator()(const Key& key) const
+{
+	std::uint64_t hash = 14695981039346656037ULL;
+	for(size_t i=0; i < key.size(); ++i)
+	{
+		hash ^= static_cast<std::uint32_t>(key[i]);
+		hash *= 1099511628211ULL;
+	}
+	return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+// max_memory -      .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::ShortestPathCache(
+	const TGraph& graph, size_t max_memory, size_t tree_threshold)
+	: graph(graph), max_memory(max_memory), tree_threshold(tree_threshold), version(graph.get_version()),
+	memory(0), num_hits(0), num_tree_hits(0), num_misses(0)
+{
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+typename ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::Key
+	ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::make_key(
+	const std::set<int>& start_group, const std::set<int>* goal_group)
+{
+	Key key(start_group.begin(), start_group.end());
+	if(goal_group == nullptr)
+	{
+		key.push_back(TREE_SEPARATOR);
+		return key;
+	}
+	key.push_back(PATH_SEPARATOR);
+	key.insert(key.end(), goal_group->begin(), goal_group->end());
+	return key;
+}
+
+//        ; false,       .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+bool ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::find_in_tree(const Entry& tree,
+	const std::set<int>& goal_group, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	const int num_vertices = static_cast<int>(tree.tree_parents.size());
+	int best_goal = -1;
+	for(std::set<int>::const_iterator i=goal_group.begin(); i != goal_group.end(); ++i)
+	{
+		if(*i >= num_vertices || *i < 0)
+			return false;
+		if(tree.tree_parents[*i] != UNREACHED && (best_goal == -1 || tree.tree_costs[*i] < tree.tree_costs[best_goal]))
+			best_goal = *i;
+	}
+	if(best_goal == -1)
+		return false;
+
+	shortest_path_cost = tree.tree_costs[best_goal];
+	shortest_path.clear();
+	for(int current_vertex=best_goal; current_vertex != -1; current_vertex = tree.tree_parents[current_vertex])
+		shortest_path.push_front(current_vertex);
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+size_t ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::get_tree_memory() const
+{
+	return static_cast<size_t>(graph.get_num_vertices())*(sizeof(TEdgeWeight) + sizeof(int)) + ENTRY_OVERHEAD;
+}
+
+//        .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+bool ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::build_tree(const std::set<int>& start_group,
+	typename Search::SearchContext& context, Entry& tree) const
+{
+	Isochrone<TEdgeWeight> reachable;
+	std::vector<TEdgeWeight> budgets(1, std::numeric_limits<TEdgeWeight>::max());
+	if(start_group.empty() || !Search::find_reachable(graph, start_group, budgets, context, reachable))
+		return false;
+
+	tree.key = make_key(start_group, nullptr);
+	tree.is_found = true;
+	tree.cost = TEdgeWeight();
+	tree.tree_costs.assign(graph.get_num_vertices(), TEdgeWeight());
+	tree.tree_parents.assign(graph.get_num_vertices(), UNREACHED);
+	for(size_t i=0; i < reachable.get_num_vertices(); ++i)
+	{
+		tree.tree_costs[reachable.get_vertex(i)] = reachable.get_cost(i);
+		tree.tree_parents[reachable.get_vertex(i)] = reachable.get_parent(i);
+	}
+	tree.memory = get_tree_memory() + tree.key.size()*sizeof(int);
+	return true;
+}
+
+//   ,       .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+void ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::synchronize(std::uint64_t graph_version)
+{
+	if(graph_version == version)
+		return;
+	clear_entries();
+	version = graph_version;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+inline void ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::touch(typename EntryList::iterator entry)
+{
+	entries.splice(entries.begin(), entries, entry);
+}
+
+//  ,   ; ,     
+//     max_memory,  .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+void ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::insert(Entry& entry, std::uint64_t graph_version)
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	synchronize(graph.get_version());
+	if(graph_version != version || entry.memory > max_memory)
+		return;
+	if(entries_index.find(entry.key) != entries_index.end())
+		return;
+
+	entries.push_front(Entry());
+	entries.front().key.swap(entry.key);
+	entries.front().is_found = entry.is_found;
+	entries.front().cost = entry.cost;
+	entries.front().path.swap(entry.path);
+	entries.front().tree_costs.swap(entry.tree_costs);
+	entries.front().tree_parents.swap(entry.tree_parents);
+	entries.front().memory = entry.memory;
+	entries_index[entries.front().key] = entries.begin();
+	memory += entry.memory;
+
+	while(memory > max_memory)
+	{
+		memory -= entries.back().memory;
+		entries_index.erase(entries.back().key);
+		entries.pop_back();
+	}
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+void ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::clear_entries()
+{
+	entries.clear();
+	entries_index.clear();
+	tree_misses.clear();
+	memory = 0;
+}
+
+//         ; . AStarSearch::find_shortest_path.
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+template<typename THeuristic>
+bool ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::find_shortest_path(
+	const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	typename Search::SearchContext context;
+	return find_shortest_path(start_group, goal_group, heuristic, context, shortest_path, shortest_path_cost);
+}
+
+//    AStarSearch::find_shortest_path:     ,  
+//  ,      ,     .
+//      ,     .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+template<typename THeuristic>
+bool ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::find_shortest_path(
+	const std::set<int>& start_group, const std::set<int>& goal_group,
+	const THeuristic& heuristic, typename Search::SearchContext& context,
+	std::list<int>& shortest_path, TEdgeWeight& shortest_path_cost)
+{
+	Key key = make_key(start_group, &goal_group);
+	Key tree_key = make_key(start_group, nullptr);
+	std::uint64_t graph_version = graph.get_version();
+	bool is_tree_needed = false;
+	{
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		synchronize(graph_version);
+		typename std::unordered_map<Key, typename EntryList::iterator, KeyHash>::iterator found = entries_index.find(key);
+		if(found != entries_index.end())
+		{
+			const Entry& entry = *found->second;
+			touch(found->second);
+			++num_hits;
+			if(!entry.is_found)
+				return false;
+			shortest_path.assign(entry.path.begin(), entry.path.end());
+			shortest_path_cost = entry.cost;
+			return true;
+		}
+		found = entries_index.find(tree_key);
+		if(found != entries_index.end())
+		{
+			touch(found->second);
+			++num_tree_hits;
+			return find_in_tree(*found->second, goal_group, shortest_path, shortest_path_cost);
+		}
+		++num_misses;
+		if(tree_threshold != 0 && get_tree_memory() <= max_memory/2)
+		{
+			if(tree_misses.size() >= MAX_COUNTED_GROUPS)
+				tree_misses.clear();
+			size_t& num_group_misses = tree_misses[tree_key];
+			if(++num_group_misses >= tree_threshold)
+			{
+				tree_misses.erase(tree_key);
+				is_tree_needed = true;
+			}
+		}
+	}
+
+	Entry entry;
+	if(is_tree_needed && build_tree(start_group, context, entry))
+	{
+		bool is_found = find_in_tree(entry, goal_group, shortest_path, shortest_path_cost);
+		insert(entry, graph_version);
+		return is_found;
+	}
+
+	entry.key.swap(key);
+	entry.is_found = Search::find_shortest_path(graph, start_group, goal_group, heuristic, context,
+		shortest_path, shortest_path_cost);
+	entry.cost = entry.is_found ? shortest_path_cost : TEdgeWeight();
+	if(entry.is_found)
+		entry.path.assign(shortest_path.begin(), shortest_path.end());
+	entry.memory = sizeof(Entry) + ENTRY_OVERHEAD + (entry.key.size() + entry.path.size())*sizeof(int);
+	insert(entry, graph_version);
+	return entry.is_found;
+}
+
+//           ,    
+//   .  false,         .
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+bool ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::add_shortest_path_tree(
+	const std::set<int>& start_group, typename Search::SearchContext& context)
+{
+	std::uint64_t graph_version = graph.get_version();
+	Entry tree;
+	if(!build_tree(start_group, context, tree))
+		return false;
+	insert(tree, graph_version);
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+void ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::clear()
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	clear_entries();
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+size_t ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::get_memory_usage() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return memory;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+size_t ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::get_num_entries() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return entries.size();
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+size_t ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::get_num_hits() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return num_hits;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+size_t ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::get_num_tree_hits() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return num_tree_hits;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph>
+size_t ShortestPathCache<TVertexValue, TEdgeWeight, TGraph>::get_num_misses() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return num_misses;
+}
+#endif
@@ -4,7 +4,13 @@
 
 #include <vector>
 #include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 //   ,     .
 //     .
@@ -136,4 +142,486 @@ size_t PriorityQueue<T>::size() const
 {
 	return storage.size();
 }
+
+//       d- .
+//       [0, num_keys) (,  ),
+//        ,       O(1),
+//    (decrease_key) -  O(log n)    .
+//     : 2 -  , 4  8 -   ,
+//          .
+template<typename TPriority, int Arity = 4>
+class IndexedPriorityQueue
+{
+	static_assert(Arity >= 2, "Heap arity must be at least 2.");
+
+	struct Entry
+	{
+		int key;
+		TPriority priority;
+	};
+
+	std::vector<Entry> storage;
+	std::vector<int> positions;
+	void sift_up(size_t current, Entry entry);
+	void sift_down(size_t current, Entry entry);
+public:
+	IndexedPriorityQueue();
+	explicit IndexedPriorityQueue(size_t num_keys);
+	void resize(size_t num_keys);
+	bool empty() const;
+	size_t size() const;
+	int top() const;
+	TPriority top_priority() const;
+	void push(int key, const TPriority& priority);
+	void pop();
+	void decrease_key(int key, const TPriority& priority);
+	void update_key(int key, const TPriority& priority);
+	void remove(int key);
+	bool contains(int key) const;
+	TPriority get_priority(int key) const;
+	void clear();
+};
+
+template<typename TPriority, int Arity>
+IndexedPriorityQueue<TPriority, Arity>::IndexedPriorityQueue() { }
+
+template<typename TPriority, int Arity>
+IndexedPriorityQueue<TPriority, Arity>::IndexedPriorityQueue(size_t num_keys)
+{
+	resize(num_keys);
+}
+
+//    ; ,    , .
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::resize(size_t num_keys)
+{
+	if(num_keys > positions.size())
+		positions.resize(num_keys, -1);
+}
+
+template<typename TPriority, int Arity>
+bool IndexedPriorityQueue<TPriority, Arity>::empty() const
+{
+	return storage.empty();
+}
+
+template<typename TPriority, int Arity>
+size_t IndexedPriorityQueue<TPriority, Arity>::size() const
+{
+	return storage.size();
+}
+
+template<typename TPriority, int Arity>
+int IndexedPriorityQueue<TPriority, Arity>::top() const
+{
+	if(storage.empty())
+		throw std::out_of_range("Queue is empty.");
+	return storage.front().key;
+}
+
+template<typename TPriority, int Arity>
+TPriority IndexedPriorityQueue<TPriority, Arity>::top_priority() const
+{
+	if(storage.empty())
+		throw std::out_of_range("Queue is empty.");
+	return storage.front().priority;
+}
+
+//   entry   current,      .
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::sift_up(size_t current, Entry entry)
+{
+	while(current > 0)
+	{
+		size_t parent = (current - 1)/Arity;
+		if(!(entry.priority < storage[parent].priority))
+			break;
+		storage[current] = storage[parent];
+		positions[storage[current].key] = static_cast<int>(current);
+		current = parent;
+	}
+	storage[current] = entry;
+	positions[entry.key] = static_cast<int>(current);
+}
+
+//   entry   current,       Arity .
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::sift_down(size_t current, Entry entry)
+{
+	size_t count = storage.size();
+	while(true)
+	{
+		size_t first_child = current*Arity + 1;
+		if(first_child >= count)
+			break;
+		size_t last_child = first_child + Arity < count ? first_child + Arity : count;
+		size_t min_child = first_child;
+		for(size_t child=first_child+1; child < last_child; ++child)
+			if(storage[child].priority < storage[min_child].priority)
+				min_child = child;
+		if(!(storage[min_child].priority < entry.priority))
+			break;
+		storage[current] = storage[min_child];
+		positions[storage[current].key] = static_cast<int>(current);
+		current = min_child;
+	}
+	storage[current] = entry;
+	positions[entry.key] = static_cast<int>(current);
+}
+
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::push(int key, const TPriority& priority)
+{
+	if(key < 0 || static_cast<size_t>(key) >= positions.size())
+		throw std::out_of_range("Key is out of range.");
+	if(positions[key] != -1)
+		throw std::invalid_argument("Key is already in queue.");
+
+	Entry entry;
+	entry.key = key;
+	entry.priority = priority;
+	storage.push_back(entry);
+	sift_up(storage.size() - 1, entry);
+}
+
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::pop()
+{
+	if(storage.empty())
+		throw std::out_of_range("Queue is empty.");
+
+	positions[storage.front().key] = -1;
+	Entry last = storage.back();
+	storage.pop_back();
+	if(!storage.empty())
+		sift_down(0, last);
+}
+
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::decrease_key(int key, const TPriority& priority)
+{
+	if(!contains(key))
+		throw std::out_of_range("Key is not in queue.");
+	size_t current = static_cast<size_t>(positions[key]);
+	if(storage[current].priority < priority)
+		throw std::invalid_argument("New priority is greater than current one.");
+
+	Entry entry = storage[current];
+	entry.priority = priority;
+	sift_up(current, entry);
+}
+
+//      .
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::update_key(int key, const TPriority& priority)
+{
+	if(!contains(key))
+		throw std::out_of_range("Key is not in queue.");
+	size_t current = static_cast<size_t>(positions[key]);
+	Entry entry = storage[current];
+	bool is_decreased = priority < entry.priority;
+	entry.priority = priority;
+	if(is_decreased)
+		sift_up(current, entry);
+	else
+		sift_down(current, entry);
+}
+
+//      :         .
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::remove(int key)
+{
+	if(!contains(key))
+		throw std::out_of_range("Key is not in queue.");
+	size_t current = static_cast<size_t>(positions[key]);
+	TPriority removed_priority = storage[current].priority;
+	positions[key] = -1;
+	Entry last = storage.back();
+	storage.pop_back();
+	if(current == storage.size())
+		return;
+	if(last.priority < removed_priority)
+		sift_up(current, last);
+	else
+		sift_down(current, last);
+}
+
+template<typename TPriority, int Arity>
+bool IndexedPriorityQueue<TPriority, Arity>::contains(int key) const
+{
+	return key >= 0 && static_cast<size_t>(key) < positions.size() && positions[key] != -1;
+}
+
+template<typename TPriority, int Arity>
+TPriority IndexedPriorityQueue<TPriority, Arity>::get_priority(int key) const
+{
+	if(!contains(key))
+		throw std::out_of_range("Key is not in queue.");
+	return storage[positions[key]].priority;
+}
+
+//    ,      ,    .
+template<typename TPriority, int Arity>
+void IndexedPriorityQueue<TPriority, Arity>::clear()
+{
+	for(size_t i=0; i < storage.size(); ++i)
+		positions[storage[i].key] = -1;
+	storage.clear();
+}
+
+//    (radix heap)    ,   IndexedPriorityQueue,
+//   .  ,      
+// ( , A*   ):       .
+//    :   0    ,   
+//  last,   i > 0 - ,      last    i - 1.
+//   0 , top()      ,    last 
+//      .         ,
+//      O( )     ,
+//  decrease_key -  O(1):     .
+//   last ( , ,   )   last:
+//     ,     ,       .
+// top()  top_priority()    ,    .
+template<typename TPriority>
+class RadixHeap
+{
+	static_assert(std::is_integral<TPriority>::value, "Radix heap priorities must be integral.");
+	typedef typename std::make_unsigned<TPriority>::type Radix;
+	static const int NUM_BUCKETS = static_cast<int>(sizeof(Radix)*CHAR_BIT) + 1;
+
+	struct Entry
+	{
+		int key;
+		TPriority priority;
+	};
+
+	std::vector<Entry> buckets[NUM_BUCKETS];
+	std::vector<int> positions;
+	std::vector<unsigned char> key_buckets;
+	size_t num_entries;
+	Radix last;
+
+	static Radix to_radix(const TPriority& priority);
+	int get_bucket(const TPriority& priority) const;
+	void insert(const Entry& entry);
+	void erase(const int key);
+	void refill();
+public:
+	RadixHeap();
+	explicit RadixHeap(size_t num_keys);
+	void resize(size_t num_keys);
+	bool empty() const;
+	size_t size() const;
+	int top();
+	TPriority top_priority();
+	void push(int key, const TPriority& priority);
+	void pop();
+	void decrease_key(int key, const TPriority& priority);
+	bool contains(int key) const;
+	TPriority get_priority(int key) const;
+	void clear();
+};
+
+//    :    - RadixHeap,   - IndexedPriorityQueue.
+template<typename TPriority, typename = void>
+struct SearchPriorityQueue
+{
+	typedef IndexedPriorityQueue<TPriority> type;
+};
+
+template<typename TPriority>
+struct SearchPriorityQueue<TPriority, typename std::enable_if<std::is_integral<TPriority>::value>::type>
+{
+	typedef RadixHeap<TPriority> type;
+};
+
+template<typename TPriority>
+RadixHeap<TPriority>::RadixHeap() : num_entries(0), last(0) { }
+
+template<typename TPriority>
+RadixHeap<TPriority>::RadixHeap(size_t num_keys) : num_entries(0), last(0)
+{
+	resize(num_keys);
+}
+
+//    ; ,    , .
+template<typename TPriority>
+void RadixHeap<TPriority>::resize(size_t num_keys)
+{
+	if(num_keys > positions.size())
+	{
+		positions.resize(num_keys, -1);
+		key_buckets.resize(num_keys, 0);
+	}
+}
+
+//         :      .
+template<typename TPriority>
+inline typename RadixHeap<TPriority>::Radix RadixHeap<TPriority>::to_radix(const TPriority& priority)
+{
+	Radix radix = static_cast<Radix>(priority);
+	if(std::is_signed<TPriority>::value)
+		radix ^= static_cast<Radix>(1) << (sizeof(Radix)*CHAR_BIT - 1);
+	return radix;
+}
+
+//   -     (priority xor last).
+template<typename TPriority>
+inline int RadixHeap<TPriority>::get_bucket(const TPriority& priority) const
+{
+	Radix radix = to_radix(priority);
+	if(radix <= last)
+		return 0;
+	std::uint64_t difference = static_cast<std::uint64_t>(radix ^ last);
+#ifdef _MSC_VER
+	// _BitScanReverse64    64- ,       .
+	unsigned long index;
+	if(_BitScanReverse(&index, static_cast<unsigned long>(difference >> 32)))
+		return static_cast<int>(index) + 33;
+	_BitScanReverse(&index, static_cast<unsigned long>(difference));
+	return static_cast<int>(index) + 1;
+#else
+	return 64 - __builtin_clzll(difference);
+#endif
+}
+
+template<typename TPriority>
+inline void RadixHeap<TPriority>::insert(const Entry& entry)
+{
+	int bucket = get_bucket(entry.priority);
+	positions[entry.key] = static_cast<int>(buckets[bucket].size());
+	key_buckets[entry.key] = static_cast<unsigned char>(bucket);
+	buckets[bucket].push_back(entry);
+}
+
+//     ,       .
+template<typename TPriority>
+inline void RadixHeap<TPriority>::erase(const int key)
+{
+	std::vector<Entry>& bucket = buckets[key_buckets[key]];
+	size_t position = static_cast<size_t>(positions[key]);
+	bucket[position] = bucket.back();
+	positions[bucket[position].key] = static_cast<int>(position);
+	bucket.pop_back();
+	positions[key] = -1;
+}
+
+//        0; ,   0 ,   - .
+template<typename TPriority>
+void RadixHeap<TPriority>::refill()
+{
+	int first = 1;
+	while(buckets[first].empty())
+		++first;
+	std::vector<Entry>& bucket = buckets[first];
+	Radix min_radix = to_radix(bucket[0].priority);
+	for(size_t i=1; i < bucket.size(); ++i)
+		min_radix = std::min(min_radix, to_radix(bucket[i].priority));
+	last = min_radix;
+
+	//       last    first - 1      .
+	std::vector<Entry> entries;
+	entries.swap(bucket);
+	for(size_t i=0; i < entries.size(); ++i)
+		insert(entries[i]);
+	entries.clear();
+	entries.swap(bucket);
+}
+
+template<typename TPriority>
+bool RadixHeap<TPriority>::empty() const
+{
+	return num_entries == 0;
+}
+
+template<typename TPriority>
+size_t RadixHeap<TPriority>::size() const
+{
+	return num_entries;
+}
+
+template<typename TPriority>
+int RadixHeap<TPriority>::top()
+{
+	if(num_entries == 0)
+		throw std::out_of_range("Queue is empty.");
+	if(buckets[0].empty())
+		refill();
+	return buckets[0].back().key;
+}
+
+template<typename TPriority>
+TPriority RadixHeap<TPriority>::top_priority()
+{
+	if(num_entries == 0)
+		throw std::out_of_range("Queue is empty.");
+	if(buckets[0].empty())
+		refill();
+	return buckets[0].back().priority;
+}
+
+template<typename TPriority>
+void RadixHeap<TPriority>::push(int key, const TPriority& priority)
+{
+	if(key < 0 || static_cast<size_t>(key) >= positions.size())
+		throw std::out_of_range("Key is out of range.");
+	if(positions[key] != -1)
+		throw std::invalid_argument("Key is already in queue.");
+
+	Entry entry;
+	entry.key = key;
+	entry.priority = priority;
+	insert(entry);
+	++num_entries;
+}
+
+//  ,    top().
+template<typename TPriority>
+void RadixHeap<TPriority>::pop()
+{
+	erase(top());
+	--num_entries;
+}
+
+template<typename TPriority>
+void RadixHeap<TPriority>::decrease_key(int key, const TPriority& priority)
+{
+	if(!contains(key))
+		throw std::out_of_range("Key is not in queue.");
+	Entry entry = buckets[key_buckets[key]][positions[key]];
+	if(entry.priority < priority)
+		throw std::invalid_argument("New priority is greater than current one.");
+
+	erase(key);
+	entry.priority = priority;
+	insert(entry);
+}
+
+template<typename TPriority>
+bool RadixHeap<TPriority>::contains(int key) const
+{
+	return key >= 0 && static_cast<size_t>(key) < positions.size() && positions[key] != -1;
+}
+
+template<typename TPriority>
+TPriority RadixHeap<TPriority>::get_priority(int key) const
+{
+	if(!contains(key))
+		throw std::out_of_range("Key is not in queue.");
+	return buckets[key_buckets[key]][positions[key]].priority;
+}
+
+//    ,      ,   last
+//    ,         .
+template<typename TPriority>
+void RadixHeap<TPriority>::clear()
+{
+	for(int i=0; i < NUM_BUCKETS; ++i)
+	{
+		for(size_t j=0; j < buckets[i].size(); ++j)
+			positions[buckets[i][j].key] = -1;
+		buckets[i].clear();
+	}
+	num_entries = 0;
+	last = 0;
+}
 #endif
\ No newline at end of file
@@ -0,0 +1,264 @@
+#pragma once
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <set>
+#include <vector>
+#include "graph.h"
+#include "graphio.h"
+
+//   .   -     (,   ),
+//  -    ,  apply().
+//         (to_internal),   -  (to_external).
+class VertexPermutation
+{
+	std::vector<int> internal_ids;
+	std::vector<int> external_ids;
+public:
+	VertexPermutation() { }
+	explicit VertexPermutation(const std::vector<int>& order);
+	int get_num_vertices() const { return static_cast<int>(internal_ids.size()); }
+	int get_internal_id(const int external_id) const;
+	int get_external_id(const int internal_id) const;
+	bool to_internal(const std::set<int>& external_group, std::set<int>& internal_group) const;
+	void to_external(std::list<int>& path) const;
+	template<typename TVertexValue, typename TEdgeWeight>
+	Graph<TVertexValue, TEdgeWeight> apply(const Graph<TVertexValue, TEdgeWeight>& graph) const;
+};
+
+//  ,         .
+//           ;    ,
+//            .
+//      (point)     ,
+//   -    -  (       ).
+class GraphReordering
+{
+	//   :  2^HILBERT_ORDER x 2^HILBERT_ORDER .
+	static const int HILBERT_ORDER = 16;
+
+	static std::uint64_t get_hilbert_index(std::uint32_t x, std::uint32_t y);
+public:
+	template<typename TVertexValue, typename TEdgeWeight>
+	static VertexPermutation compute(const Graph<TVertexValue, TEdgeWeight>& graph);
+	template<typename TEdgeWeight>
+	static VertexPermutation compute(const Graph<point, TEdgeWeight>& graph);
+	template<typename TGraph>
+	static VertexPermutation hilbert_order(const TGraph& graph);
+	template<typename TGraph>
+	static VertexPermutation cuthill_mckee_order(const TGraph& graph);
+};
+
+// order[i] -   ,     i.
+inline VertexPermutation::VertexPermutation(const std::vector<int>& order)
+	: internal_ids(order.size()), external_ids(order)
+{
+	for(size_t i=0; i < order.size(); ++i)
+		internal_ids[order[i]] = static_cast<int>(i);
+}
+
+//  -1   .
+inline int VertexPermutation::get_internal_id(const int external_id) const
+{
+	if(external_id >= get_num_vertices() || external_id < 0)
+		return -1;
+	return internal_ids[external_id];
+}
+
+inline int VertexPermutation::get_external_id(const int internal_id) const
+{
+	if(internal_id >= get_num_vertices() || internal_id < 0)
+		return -1;
+	return external_ids[internal_id];
+}
+
+//  false,      .
+inline bool VertexPermutation::to_internal(const std::set<int>& external_group, std::set<int>& internal_group) const
+{
+	internal_group.clear();
+	for(std::set<int>::const_iterator i=external_group.begin(); i != external_group.end(); ++i)
+	{
+		int internal_id = get_internal_id(*i);
+		if(internal_id == -1)
+			return false;
+		internal_group.insert(internal_id);
+	}
+	return true;
+}
+
+//      .
+inline void VertexPermutation::to_external(std::list<int>& path) const
+{
+	for(std::list<int>::iterator i=path.begin(); i != path.end(); ++i)
+		*i = get_external_id(*i);
+}
+
+//   :     v   get_internal_id(v),
+//     (      ) .
+//          .
+template<typename TVertexValue, typename TEdgeWeight>
+Graph<TVertexValue, TEdgeWeight> VertexPermutation::apply(const Graph<TVertexValue, TEdgeWeight>& graph) const
+{
+	const int num_vertices = graph.get_num_vertices();
+	Graph<TVertexValue, TEdgeWeight> reordered(num_vertices);
+	TVertexValue value = TVertexValue();
+	typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors;
+	std::vector<EdgeListEntry<TEdgeWeight>> edges;
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_vertex_value(v, value);
+		reordered.set_vertex_value(internal_ids[v], value);
+		graph.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			if(internal_ids[v] <= internal_ids[neighbors.destination(i)])
+				edges.push_back(EdgeListEntry<TEdgeWeight>(internal_ids[v],
+					internal_ids[neighbors.destination(i)], neighbors.weight(i)));
+	}
+	//  :       ,  add_edges  
+	//      - ,   get_edge_weight.
+	std::stable_sort(edges.begin(), edges.end(), [](const EdgeListEntry<TEdgeWeight>& first, const EdgeListEntry<TEdgeWeight>& second)
+	{
+		return first.origin < second.origin || (first.origin == second.origin && first.destination < second.destination);
+	});
+	reordered.add_edges(edges);
+
+	// add_edges      ;     .
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			if(internal_ids[neighbors.destination(i)] < internal_ids[v])
+				reordered.set_edge_weight(internal_ids[v], internal_ids[neighbors.destination(i)], neighbors.weight(i));
+	}
+	return reordered;
+}
+
+//   (x, y)   .
+inline std::uint64_t GraphReordering::get_hilbert_index(std::uint32_t x, std::uint32_t y)
+{
+	const std::uint32_t side = static_cast<std::uint32_t>(1) << HILBERT_ORDER;
+	std::uint64_t index = 0;
+	for(std::uint32_t s=side/2; s > 0; s/=2)
+	{
+		std::uint32_t rx = (x & s) > 0 ? 1 : 0;
+		std::uint32_t ry = (y & s) > 0 ? 1 : 0;
+		index += static_cast<std::uint64_t>(s)*s*((3*rx) ^ ry);
+		if(ry == 0)
+		{
+			if(rx == 1)
+			{
+				x = side - 1 - x;
+				y = side - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return index;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+VertexPermutation GraphReordering::compute(const Graph<TVertexValue, TEdgeWeight>& graph)
+{
+	return cuthill_mckee_order(graph);
+}
+
+template<typename TEdgeWeight>
+VertexPermutation GraphReordering::compute(const Graph<point, TEdgeWeight>& graph)
+{
+	return hilbert_order(graph);
+}
+
+//      ,    ,
+//         .
+template<typename TGraph>
+VertexPermutation GraphReordering::hilbert_order(const TGraph& graph)
+{
+	const int num_vertices = graph.get_num_vertices();
+	std::vector<point> coordinates(num_vertices);
+	double min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_vertex_value(v, coordinates[v]);
+		if(v == 0 || coordinates[v].first < min_x)
+			min_x = coordinates[v].first;
+		if(v == 0 || coordinates[v].second < min_y)
+			min_y = coordinates[v].second;
+		if(v == 0 || coordinates[v].first > max_x)
+			max_x = coordinates[v].first;
+		if(v == 0 || coordinates[v].second > max_y)
+			max_y = coordinates[v].second;
+	}
+
+	const double max_cell = static_cast<double>((static_cast<std::uint32_t>(1) << HILBERT_ORDER) - 1);
+	double extent = std::max(max_x - min_x, max_y - min_y);
+	double scale = extent > 0 ? max_cell/extent : 0.0;
+	std::vector<std::pair<std::uint64_t, int>> keys(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+	{
+		std::uint32_t x = static_cast<std::uint32_t>((coordinates[v].first - min_x)*scale);
+		std::uint32_t y = static_cast<std::uint32_t>((coordinates[v].second - min_y)*scale);
+		keys[v] = std::make_pair(get_hilbert_index(x, y), v);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	std::vector<int> order(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+		order[v] = keys[v].second;
+	return VertexPermutation(order);
+}
+
+//    - :        
+//  ,         ,
+//    .
+template<typename TGraph>
+VertexPermutation GraphReordering::cuthill_mckee_order(const TGraph& graph)
+{
+	const int num_vertices = graph.get_num_vertices();
+	typename TGraph::NeighborRange neighbors;
+	std::vector<size_t> degrees(num_vertices);
+	std::vector<int> seeds(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		degrees[v] = neighbors.size();
+		seeds[v] = v;
+	}
+	std::stable_sort(seeds.begin(), seeds.end(), [&degrees](int first, int second)
+	{
+		return degrees[first] < degrees[second];
+	});
+
+	//      order:   [head, order.size())   .
+	std::vector<int> order;
+	order.reserve(num_vertices);
+	std::vector<bool> is_visited(num_vertices, false);
+	std::vector<int> unvisited_neighbors;
+	for(int i=0; i < num_vertices; ++i)
+	{
+		if(is_visited[seeds[i]])
+			continue;
+		is_visited[seeds[i]] = true;
+		order.push_back(seeds[i]);
+		for(size_t head=order.size() - 1; head < order.size(); ++head)
+		{
+			graph.get_neighbor_range(order[head], neighbors);
+			unvisited_neighbors.clear();
+			for(size_t j=0; j < neighbors.size(); ++j)
+				if(!is_visited[neighbors.destination(j)])
+				{
+					is_visited[neighbors.destination(j)] = true;
+					unvisited_neighbors.push_back(neighbors.destination(j));
+				}
+			std::stable_sort(unvisited_neighbors.begin(), unvisited_neighbors.end(), [&degrees](int first, int second)
+			{
+				return degrees[first] < degrees[second];
+			});
+			order.insert(order.end(), unvisited_neighbors.begin(), unvisited_neighbors.end());
+		}
+	}
+	std::reverse(order.begin(), order.end());
+	return VertexPermutation(order);
+}
+#endif
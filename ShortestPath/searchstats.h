@@ -0,0 +1,108 @@
+#pragma once
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <chrono>
+#include <cstddef>
+
+//   .   AStarSearch::find_shortest_path  find_shortest_path_bidirectional
+//   :    on_*()  begin_*()/end_*()    .
+//    ,         ;
+// clear()  .    steady_clock: heuristic_seconds -  ,
+// expansion_seconds -     (  ,  ,  ).
+//            .
+struct SearchStatistics
+{
+	size_t num_settled;
+	size_t num_discovered;
+	size_t num_pushes;
+	size_t num_pops;
+	size_t num_decrease_keys;
+	size_t num_heuristic_evaluations;
+	size_t num_edges_relaxed;
+	double heuristic_seconds;
+	double expansion_seconds;
+
+	SearchStatistics() { clear(); }
+	void clear();
+
+	void begin_search();
+	void end_search();
+	void begin_heuristic() { heuristic_start = std::chrono::steady_clock::now(); }
+	void end_heuristic();
+	void on_settle() { ++num_settled; }
+	void on_discover() { ++num_discovered; }
+	void on_push() { ++num_pushes; }
+	void on_pop() { ++num_pops; }
+	void on_decrease_key() { ++num_decrease_keys; }
+	void on_relax() { ++num_edges_relaxed; }
+
+private:
+	std::chrono::steady_clock::time_point search_start;
+	std::chrono::steady_clock::time_point heuristic_start;
+	double search_heuristic_seconds;
+};
+
+// ,    .     ,
+//          ,     .
+struct NoSearchStatistics
+{
+	void begin_search() { }
+	void end_search() { }
+	void begin_heuristic() { }
+	void end_heuristic() { }
+	void on_settle() { }
+	void on_discover() { }
+	void on_push() { }
+	void on_pop() { }
+	void on_decrease_key() { }
+	void on_relax() { }
+};
+
+//  begin_search()    end_search()     ,
+//         .
+template<typename TStatisticsPolicy>
+class SearchStatisticsScope
+{
+	TStatisticsPolicy& statistics;
+
+	SearchStatisticsScope(const SearchStatisticsScope&);
+	SearchStatisticsScope& operator=(const SearchStatisticsScope&);
+public:
+	explicit SearchStatisticsScope(TStatisticsPolicy& statistics) : statistics(statistics) { statistics.begin_search(); }
+	~SearchStatisticsScope() { statistics.end_search(); }
+};
+
+inline void SearchStatistics::clear()
+{
+	num_settled = 0;
+	num_discovered = 0;
+	num_pushes = 0;
+	num_pops = 0;
+	num_decrease_keys = 0;
+	num_heuristic_evaluations = 0;
+	num_edges_relaxed = 0;
+	heuristic_seconds = 0;
+	expansion_seconds = 0;
+	search_heuristic_seconds = 0;
+}
+
+inline void SearchStatistics::begin_search()
+{
+	search_heuristic_seconds = 0;
+	search_start = std::chrono::steady_clock::now();
+}
+
+inline void SearchStatistics::end_search()
+{
+	double search_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - search_start).count();
+	heuristic_seconds += search_heuristic_seconds;
+	expansion_seconds += search_seconds > search_heuristic_seconds ? search_seconds - search_heuristic_seconds : 0.0;
+}
+
+inline void SearchStatistics::end_heuristic()
+{
+	++num_heuristic_evaluations;
+	search_heuristic_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - heuristic_start).count();
+}
+#endif
@@ -0,0 +1,206 @@
+#pragma once
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//      (work stealing).
+//       :       ,
+//    ,       .
+//      ,        
+// (,   )        .
+class ThreadPool
+{
+public:
+	typedef std::function<void(size_t worker)> Task;
+
+	explicit ThreadPool(size_t num_threads = 0);
+	~ThreadPool();
+	size_t get_num_threads() const;
+	void submit(const Task& task);
+	void wait();
+	void parallel_for(size_t count, const std::function<void(size_t index, size_t worker)>& body);
+
+private:
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable task_available;
+	std::condition_variable all_done;
+	long long num_queued;
+	size_t num_pending;
+	size_t next_queue;
+	bool is_stopping;
+	std::exception_ptr first_exception;
+
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+	bool try_pop(size_t worker, Task& task);
+	void run(size_t worker);
+};
+
+//  num_threads == 0       .
+inline ThreadPool::ThreadPool(size_t num_threads)
+	: num_queued(0), num_pending(0), next_queue(0), is_stopping(false)
+{
+	if(num_threads == 0)
+		num_threads = std::thread::hardware_concurrency();
+	if(num_threads == 0)
+		num_threads = 1;
+
+	for(size_t i=0; i < num_threads; ++i)
+		queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+	for(size_t i=0; i < num_threads; ++i)
+		threads.push_back(std::thread(&ThreadPool::run, this, i));
+}
+
+//        .
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		is_stopping = true;
+	}
+	task_available.notify_all();
+	for(size_t i=0; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+inline size_t ThreadPool::get_num_threads() const
+{
+	return threads.size();
+}
+
+//       ;    .
+inline void ThreadPool::submit(const Task& task)
+{
+	size_t queue;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		queue = next_queue;
+		next_queue = (next_queue + 1) % queues.size();
+		++num_pending;
+	}
+	{
+		std::unique_lock<std::mutex> lock(queues[queue]->mutex);
+		queues[queue]->tasks.push_back(task);
+	}
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		++num_queued;
+	}
+	task_available.notify_one();
+}
+
+//     .
+//  -   ,      .
+//    ,     .
+inline void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	all_done.wait(lock, [this] { return num_pending == 0; });
+	if(first_exception)
+	{
+		std::exception_ptr exception = first_exception;
+		first_exception = nullptr;
+		std::rethrow_exception(exception);
+	}
+}
+
+//  body(index, worker)   index  [0, count)   .
+//    ,     ,  ,    .
+inline void ThreadPool::parallel_for(size_t count, const std::function<void(size_t index, size_t worker)>& body)
+{
+	if(count == 0)
+		return;
+
+	size_t num_blocks = threads.size()*8;
+	size_t block_size = (count + num_blocks - 1)/num_blocks;
+	for(size_t first=0; first < count; first += block_size)
+	{
+		size_t last = first + block_size < count ? first + block_size : count;
+		submit([first, last, &body](size_t worker)
+		{
+			for(size_t index=first; index < last; ++index)
+				body(index, worker);
+		});
+	}
+	wait();
+}
+
+//      ,     -     .
+inline bool ThreadPool::try_pop(size_t worker, Task& task)
+{
+	{
+		std::unique_lock<std::mutex> lock(queues[worker]->mutex);
+		if(!queues[worker]->tasks.empty())
+		{
+			task = queues[worker]->tasks.back();
+			queues[worker]->tasks.pop_back();
+			return true;
+		}
+	}
+
+	for(size_t i=1; i < queues.size(); ++i)
+	{
+		WorkerQueue& victim = *queues[(worker + i) % queues.size()];
+		std::unique_lock<std::mutex> lock(victim.mutex);
+		if(!victim.tasks.empty())
+		{
+			task = victim.tasks.front();
+			victim.tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+inline void ThreadPool::run(size_t worker)
+{
+	Task task;
+	while(true)
+	{
+		if(try_pop(worker, task))
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				--num_queued;
+			}
+			try
+			{
+				task(worker);
+			}
+			catch(...)
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if(!first_exception)
+					first_exception = std::current_exception();
+			}
+			task = Task();
+
+			std::unique_lock<std::mutex> lock(mutex);
+			if(--num_pending == 0)
+				all_done.notify_all();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		task_available.wait(lock, [this] { return num_queued > 0 || is_stopping; });
+		if(is_stopping && num_queued <= 0)
+			return;
+	}
+}
+#endif
@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "graphgen.h"
+#include "reorder.h"
+#include "compactgraph.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+//  ;      --name value.
+struct BenchmarkOptions
+{
+	string graph_type;
+	string shape;
+	string heuristic;
+	int num_vertices;
+	double average_degree;
+	int num_queries;
+	int group_size;
+	int num_warmup_queries;
+	unsigned int seed;
+	bool use_snapshot;
+	bool use_compact;
+	bool use_reordering;
+	bool collect_statistics;
+
+	BenchmarkOptions() : graph_type("grid"), shape("point"), heuristic("euclidean"), num_vertices(100000),
+		average_degree(6.0), num_queries(1000), group_size(1), num_warmup_queries(10), seed(1), use_snapshot(false),
+		use_compact(false), use_reordering(false), collect_statistics(false) { }
+};
+
+//      .
+size_t get_peak_memory()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+#else
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss)*1024;
+#endif
+#endif
+}
+
+template<typename T>
+T get_percentile(const vector<T>& sorted_values, double percentile)
+{
+	if(sorted_values.empty())
+		return T();
+	size_t index = static_cast<size_t>(percentile/100.0*(sorted_values.size() - 1) + 0.5);
+	return sorted_values[min(index, sorted_values.size() - 1)];
+}
+
+template<typename T>
+void print_distribution(ostream& out_stream, const char* name, vector<T> values, const char* separator)
+{
+	sort(values.begin(), values.end());
+	double sum = 0;
+	for(size_t i=0; i < values.size(); ++i)
+		sum += static_cast<double>(values[i]);
+	out_stream << "  \"" << name << "\": {\"mean\": " << (values.empty() ? 0.0 : sum/values.size())
+		<< ", \"p50\": " << get_percentile(values, 50) << ", \"p90\": " << get_percentile(values, 90)
+		<< ", \"p99\": " << get_percentile(values, 99) << ", \"max\": " << (values.empty() ? T() : values.back())
+		<< "}" << separator << endl;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+Graph<TVertexValue, TEdgeWeight> generate_graph(const BenchmarkOptions& options)
+{
+	if(options.graph_type == "grid")
+	{
+		int width = static_cast<int>(sqrt(static_cast<double>(options.num_vertices)));
+		return GraphGenerator::grid<TVertexValue, TEdgeWeight>(width, options.num_vertices/width, options.seed);
+	}
+	if(options.graph_type == "geometric")
+		return GraphGenerator::random_geometric<TVertexValue, TEdgeWeight>(
+			options.num_vertices, options.average_degree, options.seed);
+	if(options.graph_type == "powerlaw")
+		return GraphGenerator::power_law<TVertexValue, TEdgeWeight>(
+			options.num_vertices, max(1, static_cast<int>(options.average_degree/2)), options.seed);
+	throw invalid_argument("Unknown graph type: " + options.graph_type);
+}
+
+//      -  ,      seed,
+//         .
+void generate_queries(int num_vertices, const BenchmarkOptions& options, int num_queries,
+	mt19937& generator, vector<pair<set<int>, set<int>>>& queries)
+{
+	uniform_int_distribution<int> random_vertex(0, num_vertices - 1);
+	queries.resize(num_queries);
+	for(int i=0; i < num_queries; ++i)
+	{
+		queries[i].first.clear();
+		queries[i].second.clear();
+		for(int j=0; j < options.group_size; ++j)
+			queries[i].first.insert(random_vertex(generator));
+		for(int j=0; j < options.group_size; ++j)
+			queries[i].second.insert(random_vertex(generator));
+	}
+}
+
+//        .
+void reorder_queries(const VertexPermutation& permutation, vector<pair<set<int>, set<int>>>& queries)
+{
+	set<int> internal_group;
+	for(size_t i=0; i < queries.size(); ++i)
+	{
+		permutation.to_internal(queries[i].first, internal_group);
+		queries[i].first.swap(internal_group);
+		permutation.to_internal(queries[i].second, internal_group);
+		queries[i].second.swap(internal_group);
+	}
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename TGraph, typename THeuristic>
+void run_queries(const TGraph& graph, const BenchmarkOptions& options, const VertexPermutation& permutation,
+	const THeuristic& heuristic, double build_seconds)
+{
+	mt19937 generator(options.seed + 1);
+	vector<pair<set<int>, set<int>>> warmup_queries, queries;
+	generate_queries(graph.get_num_vertices(), options, options.num_warmup_queries, generator, warmup_queries);
+	generate_queries(graph.get_num_vertices(), options, options.num_queries, generator, queries);
+	if(options.use_reordering)
+	{
+		reorder_queries(permutation, warmup_queries);
+		reorder_queries(permutation, queries);
+	}
+
+	typename AStarSearch<TVertexValue, TEdgeWeight>::SearchContext context;
+	list<int> shortest_path;
+	TEdgeWeight shortest_path_cost;
+	for(size_t i=0; i < warmup_queries.size(); ++i)
+		AStarSearch<TVertexValue, TEdgeWeight>::find_shortest_path(graph, warmup_queries[i].first,
+			warmup_queries[i].second, heuristic, context, shortest_path, shortest_path_cost);
+
+	vector<double> latencies(queries.size());
+	vector<size_t> settled(queries.size());
+	SearchStatistics statistics;
+	int num_found = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for(size_t i=0; i < queries.size(); ++i)
+	{
+		chrono::steady_clock::time_point query_start = chrono::steady_clock::now();
+		bool is_found = options.collect_statistics ?
+			AStarSearch<TVertexValue, TEdgeWeight>::find_shortest_path(graph, queries[i].first, queries[i].second,
+				heuristic, context, statistics, shortest_path, shortest_path_cost) :
+			AStarSearch<TVertexValue, TEdgeWeight>::find_shortest_path(graph, queries[i].first, queries[i].second,
+				heuristic, context, shortest_path, shortest_path_cost);
+		if(is_found)
+			++num_found;
+		latencies[i] = chrono::duration<double, micro>(chrono::steady_clock::now() - query_start).count();
+		settled[i] = context.get_num_settled();
+	}
+	double total_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	size_t num_edges = 0;
+	typename TGraph::NeighborRange neighbors;
+	for(int v=0; v < graph.get_num_vertices(); ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		num_edges += neighbors.size();
+	}
+
+	cout << "{" << endl;
+	cout << "  \"graph\": {\"type\": \"" << options.graph_type << "\", \"shape\": \"" << options.shape
+		<< "\", \"vertices\": " << graph.get_num_vertices() << ", \"edges\": " << num_edges/2
+		<< ", \"seed\": " << options.seed << ", \"snapshot\": " << (options.use_snapshot ? "true" : "false")
+		<< ", \"compact\": " << (options.use_compact ? "true" : "false")
+		<< ", \"reordered\": " << (options.use_reordering ? "true" : "false")
+		<< ", \"build_seconds\": " << build_seconds << "}," << endl;
+	cout << "  \"heuristic\": \"" << options.heuristic << "\"," << endl;
+	cout << "  \"queries\": " << queries.size() << "," << endl;
+	cout << "  \"group_size\": " << options.group_size << "," << endl;
+	cout << "  \"found\": " << num_found << "," << endl;
+	cout << "  \"total_seconds\": " << total_seconds << "," << endl;
+	cout << "  \"throughput_qps\": " << (total_seconds > 0 ? queries.size()/total_seconds : 0.0) << "," << endl;
+	print_distribution(cout, "latency_us", latencies, ",");
+	print_distribution(cout, "settled_vertices", settled, ",");
+	if(options.collect_statistics)
+		cout << "  \"statistics\": {\"settled\": " << statistics.num_settled << ", \"discovered\": " << statistics.num_discovered
+			<< ", \"pushes\": " << statistics.num_pushes << ", \"pops\": " << statistics.num_pops
+			<< ", \"decrease_keys\": " << statistics.num_decrease_keys
+			<< ", \"heuristic_evaluations\": " << statistics.num_heuristic_evaluations
+			<< ", \"edges_relaxed\": " << statistics.num_edges_relaxed
+			<< ", \"heuristic_seconds\": " << statistics.heuristic_seconds
+			<< ", \"expansion_seconds\": " << statistics.expansion_seconds << "}," << endl;
+	cout << "  \"peak_memory_bytes\": " << get_peak_memory() << endl;
+	cout << "}" << endl;
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void run_benchmark(const BenchmarkOptions& options, const THeuristic& heuristic)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Graph<TVertexValue, TEdgeWeight> graph = generate_graph<TVertexValue, TEdgeWeight>(options);
+	VertexPermutation permutation;
+	if(options.use_reordering)
+	{
+		permutation = GraphReordering::compute(graph);
+		graph = permutation.apply(graph);
+	}
+	if(options.use_compact)
+	{
+		CompactGraph<TVertexValue, TEdgeWeight> compact(graph);
+		graph = Graph<TVertexValue, TEdgeWeight>(0);
+		double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		run_queries<TVertexValue, TEdgeWeight>(compact, options, permutation, heuristic, build_seconds);
+	}
+	else if(options.use_snapshot)
+	{
+		CSRGraph<TVertexValue, TEdgeWeight> snapshot(graph);
+		graph = Graph<TVertexValue, TEdgeWeight>(0);
+		double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		run_queries<TVertexValue, TEdgeWeight>(snapshot, options, permutation, heuristic, build_seconds);
+	}
+	else
+	{
+		double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		run_queries<TVertexValue, TEdgeWeight>(graph, options, permutation, heuristic, build_seconds);
+	}
+}
+
+void print_usage()
+{
+	cerr << "Usage: shortestpath_bench [options]" << endl
+		<< "  --graph grid|geometric|powerlaw   graph generator (grid)" << endl
+		<< "  --shape point|int                 Graph<point,double> or Graph<int,int> (point)" << endl
+		<< "  --heuristic euclidean|zero        heuristic for the point shape (euclidean)" << endl
+		<< "  --vertices N                      number of vertices (100000)" << endl
+		<< "  --degree D                        average degree for geometric and powerlaw graphs (6)" << endl
+		<< "  --queries N                       number of measured queries (1000)" << endl
+		<< "  --warmup N                        number of warm-up queries (10)" << endl
+		<< "  --group-size N                    vertices in each start and goal group (1)" << endl
+		<< "  --seed N                          seed of the graph and the workload (1)" << endl
+		<< "  --snapshot                        search on a CSRGraph snapshot" << endl
+		<< "  --compact                         search on a CompactGraph with 16-bit quantized weights" << endl
+		<< "  --reorder                         renumber vertices for cache locality (see reorder.h)" << endl
+		<< "  --stats                           collect SearchStatistics (adds timing overhead)" << endl;
+}
+
+bool parse_options(int argc, char* argv[], BenchmarkOptions& options)
+{
+	for(int i=1; i < argc; ++i)
+	{
+		string name = argv[i];
+		if(name == "--snapshot")
+		{
+			options.use_snapshot = true;
+			continue;
+		}
+		if(name == "--compact")
+		{
+			options.use_compact = true;
+			continue;
+		}
+		if(name == "--reorder")
+		{
+			options.use_reordering = true;
+			continue;
+		}
+		if(name == "--stats")
+		{
+			options.collect_statistics = true;
+			continue;
+		}
+		if(i + 1 >= argc)
+			return false;
+		string value = argv[++i];
+		if(name == "--graph")
+			options.graph_type = value;
+		else if(name == "--shape")
+			options.shape = value;
+		else if(name == "--heuristic")
+			options.heuristic = value;
+		else if(name == "--vertices")
+			options.num_vertices = atoi(value.c_str());
+		else if(name == "--degree")
+			options.average_degree = atof(value.c_str());
+		else if(name == "--queries")
+			options.num_queries = atoi(value.c_str());
+		else if(name == "--warmup")
+			options.num_warmup_queries = atoi(value.c_str());
+		else if(name == "--group-size")
+			options.group_size = atoi(value.c_str());
+		else if(name == "--seed")
+			options.seed = static_cast<unsigned int>(strtoul(value.c_str(), nullptr, 10));
+		else
+			return false;
+	}
+	return options.num_vertices > 0 && options.num_queries >= 0 && options.num_warmup_queries >= 0 &&
+		options.group_size > 0 && (options.shape == "point" || options.shape == "int") &&
+		(options.heuristic == "euclidean" || options.heuristic == "zero");
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkOptions options;
+	if(!parse_options(argc, argv, options))
+	{
+		print_usage();
+		return 1;
+	}
+
+	try
+	{
+		if(options.shape == "int")
+		{
+			options.heuristic = "zero";
+			run_benchmark<int, int>(options, AStarSearch<int, int>::AStarDefaultHeuristic());
+		}
+		else if(options.heuristic == "euclidean")
+			run_benchmark<point, double>(options, AStarEuclidianHeuristic());
+		else
+			run_benchmark<point, double>(options, AStarSearch<point, double>::AStarDefaultHeuristic());
+	}
+	catch(const exception& exception)
+	{
+		cerr << exception.what() << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,689 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "graphio.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+//    :      ,   
+//        Unix domain socket    .
+//
+// :	ID  _ _ [max_settled=N] [max_ms=T]
+//  - optimal, bidirectional, weighted:EPS  focal:EPS (. AStarSearch::SearchOptions),
+//   -     .      
+// (bidirectional   ). :
+//
+// ID found   ... 
+// ID not_found
+// ID timed_out [  ... ]	-  ,   ,   
+// ID error 
+//
+//   ,   :   ,   
+//   ,      ID. ,     
+//   --max-queue:   ,      ,  ,
+//   ,   ,   ,     .
+//  ,    ,  (. SocketResponseChannel).
+//  stats   stats {...}   ,  
+//   .
+
+//  ;      --name value.
+struct ServerOptions
+{
+	string graph_file;
+	string format;
+	string socket_path;
+	size_t num_threads;
+	size_t max_queued;
+	size_t max_settled;
+	double max_milliseconds;
+
+	ServerOptions() : format("point"), num_threads(0), max_queued(1024), max_settled(0), max_milliseconds(0.0) { }
+};
+
+//    .      ,
+//        .
+// write_line         .
+class ResponseChannel
+{
+public:
+	virtual ~ResponseChannel() { }
+	virtual void write_line(const string& line) = 0;
+};
+
+class StreamResponseChannel : public ResponseChannel
+{
+	ostream& out_stream;
+	mutex stream_mutex;
+public:
+	explicit StreamResponseChannel(ostream& out_stream) : out_stream(out_stream) { }
+	void write_line(const string& line)
+	{
+		lock_guard<mutex> lock(stream_mutex);
+		out_stream << line << '\n' << flush;
+	}
+};
+
+#ifndef _WIN32
+// write_line     ,        .
+//           MAX_PENDING_BYTES  
+//   SEND_TIMEOUT_SECONDS ,  ,    .
+//  ,      ,    
+//    ,       ;  
+//       .
+class SocketResponseChannel : public ResponseChannel
+{
+	static const size_t MAX_PENDING_BYTES = 16 << 20;
+	static const int SEND_TIMEOUT_SECONDS = 30;
+
+	// ,      ,    .
+	struct Connection
+	{
+		int socket_descriptor;
+		mutex connection_mutex;
+		condition_variable connection_condition;
+		deque<string> lines;
+		size_t pending_bytes;
+		bool is_closing;
+		bool is_broken;
+
+		explicit Connection(int socket_descriptor) : socket_descriptor(socket_descriptor), pending_bytes(0),
+			is_closing(false), is_broken(false) { }
+	};
+
+	shared_ptr<Connection> connection;
+
+	static bool send_data(int socket_descriptor, const string& data);
+	static void send_lines(shared_ptr<Connection> connection);
+public:
+	explicit SocketResponseChannel(int socket_descriptor);
+	~SocketResponseChannel();
+	void write_line(const string& line);
+};
+
+SocketResponseChannel::SocketResponseChannel(int socket_descriptor) : connection(new Connection(socket_descriptor))
+{
+	timeval timeout;
+	timeout.tv_sec = SEND_TIMEOUT_SECONDS;
+	timeout.tv_usec = 0;
+	setsockopt(socket_descriptor, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	thread(send_lines, connection).detach();
+}
+
+SocketResponseChannel::~SocketResponseChannel()
+{
+	{
+		lock_guard<mutex> lock(connection->connection_mutex);
+		connection->is_closing = true;
+	}
+	connection->connection_condition.notify_one();
+}
+
+void SocketResponseChannel::write_line(const string& line)
+{
+	{
+		lock_guard<mutex> lock(connection->connection_mutex);
+		if(connection->is_broken)
+			return;
+		if(connection->pending_bytes + line.size() + 1 > MAX_PENDING_BYTES)
+		{
+			//    ,     .
+			connection->is_broken = true;
+			connection->lines.clear();
+			connection->pending_bytes = 0;
+			shutdown(connection->socket_descriptor, SHUT_RDWR);
+			return;
+		}
+		connection->lines.push_back(line + '\n');
+		connection->pending_bytes += line.size() + 1;
+	}
+	connection->connection_condition.notify_one();
+}
+
+bool SocketResponseChannel::send_data(int socket_descriptor, const string& data)
+{
+	size_t written = 0;
+	while(written < data.size())
+	{
+		ssize_t result = send(socket_descriptor, data.data() + written, data.size() - written, 0);
+		if(result < 0 && errno == EINTR)
+			continue;
+		if(result <= 0)
+			return false;
+		written += static_cast<size_t>(result);
+	}
+	return true;
+}
+
+//      send,        .
+void SocketResponseChannel::send_lines(shared_ptr<Connection> connection)
+{
+	unique_lock<mutex> lock(connection->connection_mutex);
+	for(;;)
+	{
+		connection->connection_condition.wait(lock, [&connection]()
+			{ return !connection->lines.empty() || connection->is_closing; });
+		if(connection->lines.empty())
+			break;
+		string data;
+		for(; !connection->lines.empty(); connection->lines.pop_front())
+			data += connection->lines.front();
+		connection->pending_bytes = 0;
+		lock.unlock();
+		bool is_sent = send_data(connection->socket_descriptor, data);
+		lock.lock();
+		if(!is_sent && !connection->is_broken)
+		{
+			connection->is_broken = true;
+			connection->lines.clear();
+			connection->pending_bytes = 0;
+			shutdown(connection->socket_descriptor, SHUT_RDWR);
+		}
+	}
+	close(connection->socket_descriptor);
+}
+#endif
+
+//  .      LATENCY_WINDOW .
+class ServerStatistics
+{
+	static const size_t LATENCY_WINDOW = 65536;
+
+	mutex statistics_mutex;
+	chrono::steady_clock::time_point start;
+	size_t num_queries;
+	size_t num_found;
+	size_t num_not_found;
+	size_t num_timed_out;
+	size_t num_errors;
+	double total_latency;
+	vector<double> latencies;
+	size_t next_latency;
+public:
+	enum Outcome { FOUND, NOT_FOUND, TIMED_OUT, FAILED };
+
+	ServerStatistics() : start(chrono::steady_clock::now()), num_queries(0), num_found(0), num_not_found(0),
+		num_timed_out(0), num_errors(0), total_latency(0.0), next_latency(0) { }
+	void add(Outcome outcome, double latency);
+	string to_json();
+};
+
+void ServerStatistics::add(Outcome outcome, double latency)
+{
+	lock_guard<mutex> lock(statistics_mutex);
+	++num_queries;
+	if(outcome == FOUND)
+		++num_found;
+	else if(outcome == NOT_FOUND)
+		++num_not_found;
+	else if(outcome == TIMED_OUT)
+		++num_timed_out;
+	else
+		++num_errors;
+	total_latency += latency;
+	if(latencies.size() < LATENCY_WINDOW)
+		latencies.push_back(latency);
+	else
+		latencies[next_latency] = latency;
+	next_latency = (next_latency + 1) % LATENCY_WINDOW;
+}
+
+string ServerStatistics::to_json()
+{
+	vector<double> sorted_latencies;
+	ostringstream out_stream;
+	{
+		lock_guard<mutex> lock(statistics_mutex);
+		sorted_latencies = latencies;
+		double uptime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		out_stream << "{\"uptime_seconds\": " << uptime << ", \"queries\": " << num_queries
+			<< ", \"found\": " << num_found << ", \"not_found\": " << num_not_found
+			<< ", \"timed_out\": " << num_timed_out << ", \"errors\": " << num_errors
+			<< ", \"qps\": " << (uptime > 0 ? num_queries/uptime : 0.0)
+			<< ", \"latency_us\": {\"mean\": " << (num_queries > 0 ? total_latency/num_queries : 0.0);
+	}
+	sort(sorted_latencies.begin(), sorted_latencies.end());
+	const double percentiles[] = { 50, 90, 99 };
+	for(size_t i=0; i < sizeof(percentiles)/sizeof(percentiles[0]); ++i)
+	{
+		double value = 0.0;
+		if(!sorted_latencies.empty())
+		{
+			size_t index = static_cast<size_t>(percentiles[i]/100.0*(sorted_latencies.size() - 1) + 0.5);
+			value = sorted_latencies[min(index, sorted_latencies.size() - 1)];
+		}
+		out_stream << ", \"p" << percentiles[i] << "\": " << value;
+	}
+	out_stream << ", \"max\": " << (sorted_latencies.empty() ? 0.0 : sorted_latencies.back()) << "}}";
+	return out_stream.str();
+}
+
+//   ;    atof,     .
+bool parse_non_negative(const string& text, double& value)
+{
+	char* end = nullptr;
+	value = strtod(text.c_str(), &end);
+	return !text.empty() && *end == '\0' && value >= 0.0 && value <= numeric_limits<double>::max();
+}
+
+//    ; , ,      .
+bool parse_size(const string& text, size_t& value)
+{
+	if(text.empty() || text.find_first_not_of("0123456789") != string::npos)
+		return false;
+	errno = 0;
+	unsigned long long number = strtoull(text.c_str(), nullptr, 10);
+	value = static_cast<size_t>(number);
+	return errno != ERANGE && number <= numeric_limits<size_t>::max();
+}
+
+//     1,2,3.
+bool parse_group(const string& text, int num_vertices, set<int>& group)
+{
+	group.clear();
+	size_t first = 0;
+	while(first <= text.size())
+	{
+		size_t last = text.find(',', first);
+		if(last == string::npos)
+			last = text.size();
+		string number = text.substr(first, last - first);
+		char* end = nullptr;
+		long vertex = strtol(number.c_str(), &end, 10);
+		if(number.empty() || *end != '\0' || vertex < 0 || vertex >= num_vertices)
+			return false;
+		group.insert(static_cast<int>(vertex));
+		first = last + 1;
+	}
+	return !group.empty();
+}
+
+//      .
+template<typename TVertexValue, typename TEdgeWeight>
+struct WorkerState
+{
+	typename AStarSearch<TVertexValue, TEdgeWeight>::SearchContext context;
+	typename AStarSearch<TVertexValue, TEdgeWeight>::BidirectionalSearchContext bidirectional_context;
+};
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+class QueryServer
+{
+	typedef AStarSearch<TVertexValue, TEdgeWeight> Search;
+
+	const CSRGraph<TVertexValue, TEdgeWeight>& graph;
+	const THeuristic& heuristic;
+	const ServerOptions& options;
+	ThreadPool& pool;
+	vector<unique_ptr<WorkerState<TVertexValue, TEdgeWeight>>> workers;
+	ServerStatistics statistics;
+	//  ,         .
+	mutex queued_mutex;
+	condition_variable queued_condition;
+	size_t num_queued;
+
+	string execute(const string& request, size_t worker, ServerStatistics::Outcome& outcome);
+public:
+	QueryServer(const CSRGraph<TVertexValue, TEdgeWeight>& graph, const THeuristic& heuristic,
+		const ServerOptions& options, ThreadPool& pool);
+	void handle_line(const string& line, const shared_ptr<ResponseChannel>& channel);
+	string get_statistics() { return statistics.to_json(); }
+};
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+QueryServer<TVertexValue, TEdgeWeight, THeuristic>::QueryServer(const CSRGraph<TVertexValue, TEdgeWeight>& graph,
+	const THeuristic& heuristic, const ServerOptions& options, ThreadPool& pool)
+	: graph(graph), heuristic(heuristic), options(options), pool(pool), num_queued(0)
+{
+	for(size_t i=0; i < pool.get_num_threads(); ++i)
+		workers.push_back(unique_ptr<WorkerState<TVertexValue, TEdgeWeight>>(new WorkerState<TVertexValue, TEdgeWeight>()));
+}
+
+//  stats     ,     .    
+// options.max_queued ,   ,       .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void QueryServer<TVertexValue, TEdgeWeight, THeuristic>::handle_line(
+	const string& line, const shared_ptr<ResponseChannel>& channel)
+{
+	if(line.find_first_not_of(" \t\r") == string::npos)
+		return;
+	if(line == "stats" || line == "stats\r")
+	{
+		channel->write_line("stats " + statistics.to_json());
+		return;
+	}
+
+	//            .
+	shared_ptr<ResponseChannel> response_channel = channel;
+	chrono::steady_clock::time_point received = chrono::steady_clock::now();
+	{
+		unique_lock<mutex> lock(queued_mutex);
+		queued_condition.wait(lock, [this]() { return num_queued < options.max_queued; });
+		++num_queued;
+	}
+	pool.submit([this, line, response_channel, received](size_t worker)
+	{
+		ServerStatistics::Outcome outcome = ServerStatistics::FAILED;
+		string response;
+		try
+		{
+			response = execute(line, worker, outcome);
+		}
+		catch(const exception& exception)
+		{
+			istringstream line_stream(line);
+			string id;
+			line_stream >> id;
+			response = id + " error " + exception.what();
+			outcome = ServerStatistics::FAILED;
+		}
+		statistics.add(outcome, chrono::duration<double, micro>(chrono::steady_clock::now() - received).count());
+		response_channel->write_line(response);
+		{
+			lock_guard<mutex> lock(queued_mutex);
+			--num_queued;
+		}
+		queued_condition.notify_one();
+	});
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+string QueryServer<TVertexValue, TEdgeWeight, THeuristic>::execute(
+	const string& request, size_t worker, ServerStatistics::Outcome& outcome)
+{
+	istringstream request_stream(request);
+	string id, mode, starts, goals;
+	outcome = ServerStatistics::FAILED;
+	if(!(request_stream >> id >> mode >> starts >> goals))
+		return (id.empty() ? string("-") : id) + " error malformed request";
+
+	set<int> start_group, goal_group;
+	if(!parse_group(starts, graph.get_num_vertices(), start_group) ||
+		!parse_group(goals, graph.get_num_vertices(), goal_group))
+		return id + " error bad vertex group";
+
+	typename Search::SearchOptions search_options;
+	search_options.max_settled = options.max_settled;
+	search_options.max_seconds = options.max_milliseconds/1000.0;
+	string parameter;
+	while(request_stream >> parameter)
+	{
+		double value;
+		if(parameter.compare(0, 12, "max_settled=") == 0)
+		{
+			if(!parse_size(parameter.substr(12), search_options.max_settled))
+				return id + " error bad parameter " + parameter;
+		}
+		else if(parameter.compare(0, 7, "max_ms=") == 0)
+		{
+			if(!parse_non_negative(parameter.substr(7), value))
+				return id + " error bad parameter " + parameter;
+			search_options.max_seconds = value/1000.0;
+		}
+		else
+			return id + " error unknown parameter " + parameter;
+	}
+
+	bool is_bidirectional = false;
+	size_t separator = mode.find(':');
+	string mode_name = mode.substr(0, separator);
+	if(mode_name == "optimal")
+		search_options.mode = Search::SearchOptions::OPTIMAL;
+	else if(mode_name == "bidirectional")
+		is_bidirectional = true;
+	else if(mode_name == "weighted")
+		search_options.mode = Search::SearchOptions::WEIGHTED;
+	else if(mode_name == "focal")
+		search_options.mode = Search::SearchOptions::FOCAL;
+	else
+		return id + " error unknown mode " + mode;
+	if(separator != string::npos && !parse_non_negative(mode.substr(separator + 1), search_options.suboptimality))
+		return id + " error bad suboptimality in mode " + mode;
+
+	WorkerState<TVertexValue, TEdgeWeight>& state = *workers[worker];
+	list<int> path;
+	TEdgeWeight path_cost = TEdgeWeight();
+	typename Search::SearchStatus status;
+	if(is_bidirectional)
+		status = Search::find_shortest_path_bidirectional(graph, start_group, goal_group, heuristic,
+			state.bidirectional_context, path, path_cost) ? Search::PATH_FOUND : Search::PATH_NOT_FOUND;
+	else
+		status = Search::find_path(graph, start_group, goal_group, heuristic, search_options, state.context,
+			path, path_cost);
+
+	ostringstream response;
+	response << id;
+	if(status == Search::PATH_FOUND)
+	{
+		outcome = ServerStatistics::FOUND;
+		response << " found";
+	}
+	else if(status == Search::SEARCH_TIMED_OUT)
+	{
+		outcome = ServerStatistics::TIMED_OUT;
+		response << " timed_out";
+	}
+	else
+	{
+		outcome = ServerStatistics::NOT_FOUND;
+		response << " not_found";
+	}
+	if(status != Search::PATH_NOT_FOUND && !path.empty())
+	{
+		response << " " << path_cost;
+		for(list<int>::const_iterator i=path.begin(); i != path.end(); ++i)
+			response << " " << *i;
+	}
+	return response.str();
+}
+
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void serve_stdin(QueryServer<TVertexValue, TEdgeWeight, THeuristic>& server, ThreadPool& pool)
+{
+	shared_ptr<ResponseChannel> channel(new StreamResponseChannel(cout));
+	string line;
+	while(getline(cin, line))
+		server.handle_line(line, channel);
+	pool.wait();
+	cerr << "stats " << server.get_statistics() << endl;
+}
+
+#ifndef _WIN32
+//    ,     .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void serve_connection(QueryServer<TVertexValue, TEdgeWeight, THeuristic>& server, int socket_descriptor)
+{
+	shared_ptr<ResponseChannel> channel(new SocketResponseChannel(socket_descriptor));
+	vector<char> buffer(65536);
+	string pending;
+	for(;;)
+	{
+		ssize_t result = recv(socket_descriptor, &buffer[0], buffer.size(), 0);
+		if(result < 0 && errno == EINTR)
+			continue;
+		if(result <= 0)
+			break;
+		pending.append(&buffer[0], static_cast<size_t>(result));
+		size_t first = 0;
+		size_t last;
+		while((last = pending.find('\n', first)) != string::npos)
+		{
+			server.handle_line(pending.substr(first, last - first), channel);
+			first = last + 1;
+		}
+		pending.erase(0, first);
+	}
+	if(!pending.empty())
+		server.handle_line(pending, channel);
+}
+
+//  ,     ;     .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void serve_socket(QueryServer<TVertexValue, TEdgeWeight, THeuristic>& server, const string& socket_path)
+{
+	signal(SIGPIPE, SIG_IGN);
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if(socket_path.size() >= sizeof(address.sun_path))
+		throw invalid_argument("Socket path is too long: " + socket_path);
+	strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+	int listen_descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(listen_descriptor < 0)
+		throw runtime_error(string("socket: ") + strerror(errno));
+	unlink(socket_path.c_str());
+	if(::bind(listen_descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+		listen(listen_descriptor, SOMAXCONN) != 0)
+	{
+		string message = string("Cannot listen on ") + socket_path + ": " + strerror(errno);
+		close(listen_descriptor);
+		throw runtime_error(message);
+	}
+	cerr << "listening on " << socket_path << endl;
+
+	for(;;)
+	{
+		int socket_descriptor = accept(listen_descriptor, nullptr, nullptr);
+		if(socket_descriptor < 0)
+		{
+			if(errno == EINTR || errno == ECONNABORTED)
+				continue;
+			string message = string("accept: ") + strerror(errno);
+			close(listen_descriptor);
+			throw runtime_error(message);
+		}
+		thread(serve_connection<TVertexValue, TEdgeWeight, THeuristic>, ref(server), socket_descriptor).detach();
+	}
+}
+#endif
+
+//      CSRGraph,      ;
+//       .
+template<typename TVertexValue, typename TEdgeWeight, typename THeuristic>
+void run_server(Graph<TVertexValue, TEdgeWeight>& loaded_graph, const ServerOptions& options,
+	const THeuristic& heuristic, ThreadPool& pool, const chrono::steady_clock::time_point& start)
+{
+	CSRGraph<TVertexValue, TEdgeWeight> graph(loaded_graph);
+	loaded_graph = Graph<TVertexValue, TEdgeWeight>(0);
+	double load_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cerr << "loaded " << graph.get_num_vertices() << " vertices, " << graph.get_num_edges()/2 << " edges in "
+		<< load_seconds << " s, " << pool.get_num_threads() << " threads" << endl;
+
+	QueryServer<TVertexValue, TEdgeWeight, THeuristic> server(graph, heuristic, options, pool);
+	if(options.socket_path.empty())
+	{
+		serve_stdin(server, pool);
+		return;
+	}
+#ifdef _WIN32
+	throw invalid_argument("Unix domain sockets are not supported on this platform; use standard input.");
+#else
+	serve_socket(server, options.socket_path);
+#endif
+}
+
+void print_usage()
+{
+	cerr << "Usage: shortestpath_server --graph FILE [options]" << endl
+		<< "  --graph FILE                      graph in the GraphIO text format" << endl
+		<< "  --format point|int                from_stream_double_double or from_stream_int format (point)" << endl
+		<< "  --socket PATH                     listen on a Unix domain socket instead of standard input" << endl
+		<< "  --threads N                       worker threads, 0 - one per hardware thread (0)" << endl
+		<< "  --max-queue N                     requests accepted but not yet answered; reading waits above it (1024)" << endl
+		<< "  --max-settled N                   default limit of settled vertices per query, 0 - none (0)" << endl
+		<< "  --max-ms T                        default time limit per query in milliseconds, 0 - none (0)" << endl;
+}
+
+bool parse_options(int argc, char* argv[], ServerOptions& options)
+{
+	for(int i=1; i < argc; ++i)
+	{
+		string name = argv[i];
+		if(i + 1 >= argc)
+			return false;
+		string value = argv[++i];
+		bool is_valid = true;
+		if(name == "--graph")
+			options.graph_file = value;
+		else if(name == "--format")
+			options.format = value;
+		else if(name == "--socket")
+			options.socket_path = value;
+		else if(name == "--threads")
+			is_valid = parse_size(value, options.num_threads);
+		else if(name == "--max-queue")
+			is_valid = parse_size(value, options.max_queued) && options.max_queued > 0;
+		else if(name == "--max-settled")
+			is_valid = parse_size(value, options.max_settled);
+		else if(name == "--max-ms")
+			is_valid = parse_non_negative(value, options.max_milliseconds);
+		else
+			return false;
+		if(!is_valid)
+		{
+			cerr << "Invalid value of " << name << ": " << value << endl;
+			return false;
+		}
+	}
+	return !options.graph_file.empty() && (options.format == "point" || options.format == "int");
+}
+
+int main(int argc, char* argv[])
+{
+	ServerOptions options;
+	if(!parse_options(argc, argv, options))
+	{
+		print_usage();
+		return 1;
+	}
+
+	try
+	{
+		ifstream file_stream(options.graph_file.c_str(), ios::binary);
+		if(!file_stream.is_open())
+			throw runtime_error("Cannot open " + options.graph_file);
+
+		ThreadPool pool(options.num_threads);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		if(options.format == "int")
+		{
+			Graph<int, int> graph = GraphIO::bulk_from_stream_int(file_stream, pool);
+			file_stream.close();
+			run_server<int, int>(graph, options, AStarSearch<int, int>::AStarDefaultHeuristic(), pool, start);
+		}
+		else
+		{
+			Graph<point, double> graph = GraphIO::bulk_from_stream_double_double(file_stream, pool);
+			file_stream.close();
+			run_server<point, double>(graph, options, AStarEuclidianHeuristic(), pool, start);
+		}
+	}
+	catch(const exception& exception)
+	{
+		cerr << exception.what() << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <list>
+#include <random>
+#include <set>
+#include "astar.h"
+#include "landmarks.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<int, int> Search;
+typedef AStarLandmarkHeuristic<int, int> LandmarkHeuristic;
+
+//     WEIGHTED  FOCAL     (1 + suboptimality)  .
+static void check_bound(Search::SearchOptions::Mode mode, double suboptimality, unsigned int seed)
+{
+	mt19937 random(seed);
+	Search::SearchOptions options;
+	options.mode = mode;
+	options.suboptimality = suboptimality;
+	for(int graph_index=0; graph_index < 20; ++graph_index)
+	{
+		const int num_vertices = 80;
+		Graph<int, int> graph = make_random_graph<int, int>(num_vertices, 200, 1, 30, graph_index % 2 == 1, random);
+		LandmarkHeuristic heuristic(graph, 4);
+		Search::SearchContext context;
+		for(int query=0; query < 100; ++query)
+		{
+			set<int> start_group = make_random_group(num_vertices, 2, random);
+			set<int> goal_group = make_random_group(num_vertices, 2, random);
+			int reference_cost;
+			bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+			list<int> path;
+			int cost = -1;
+			Search::SearchStatus status = Search::find_path(graph, start_group, goal_group, heuristic, options,
+				context, path, cost);
+			CHECK((status == Search::PATH_FOUND) == is_reachable);
+			if(status == Search::PATH_FOUND && is_reachable)
+			{
+				CHECK(reference_cost <= cost);
+				CHECK(cost <= (1.0 + suboptimality)*reference_cost);
+				CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+			}
+		}
+	}
+}
+
+int main()
+{
+	const double suboptimalities[] = { 0.1, 0.5, 1.0 };
+	for(size_t i=0; i < sizeof(suboptimalities)/sizeof(suboptimalities[0]); ++i)
+	{
+		check_bound(Search::SearchOptions::WEIGHTED, suboptimalities[i], 17 + static_cast<unsigned int>(i));
+		check_bound(Search::SearchOptions::FOCAL, suboptimalities[i], 23 + static_cast<unsigned int>(i));
+	}
+	return finish_test();
+}
@@ -0,0 +1,86 @@
+#include <atomic>
+#include <list>
+#include <random>
+#include <set>
+#include <vector>
+#include "astar.h"
+#include "csrgraph.h"
+#include "testing.h"
+#include "threadpool.h"
+
+using namespace std;
+
+typedef AStarSearch<int, double> Search;
+
+//                (  
+//    ),     find_shortest_path   .
+template<typename TGraph>
+static void check_batch(const TGraph& graph, ThreadPool& pool, mt19937& random)
+{
+	const int num_vertices = graph.get_num_vertices();
+	vector<Search::SearchQuery> queries;
+	for(int i=0; i < 300; ++i)
+		queries.push_back(Search::SearchQuery(make_random_group(num_vertices, 3, random),
+			make_random_group(num_vertices, 3, random)));
+	//           .
+	queries.push_back(Search::SearchQuery(set<int>{num_vertices}, set<int>{0}));
+
+	Search::AStarDefaultHeuristic heuristic;
+	vector<Search::SearchResult> results;
+	Search::find_shortest_paths(graph, queries, heuristic, pool, results);
+	CHECK(results.size() == queries.size());
+
+	Search::SearchContext context;
+	for(size_t i=0; i < queries.size() && i < results.size(); ++i)
+	{
+		list<int> path;
+		double cost = 0.0;
+		bool is_found = Search::find_shortest_path(graph, queries[i].first, queries[i].second, heuristic, context,
+			path, cost);
+		CHECK(results[i].is_found == is_found);
+		if(is_found && results[i].is_found)
+		{
+			CHECK(results[i].shortest_path == path);
+			CHECK(results[i].shortest_path_cost == cost);
+		}
+	}
+
+	Search::find_shortest_paths(graph, vector<Search::SearchQuery>(), heuristic, pool, results);
+	CHECK(results.empty());
+}
+
+// parallel_for        ,       .
+static void check_parallel_for(ThreadPool& pool)
+{
+	const size_t count = 10000;
+	vector<atomic<int>> calls(count);
+	atomic<bool> is_worker_valid(true);
+	pool.parallel_for(count, [&](size_t index, size_t worker)
+	{
+		++calls[index];
+		if(worker >= pool.get_num_threads())
+			is_worker_valid = false;
+	});
+	bool is_each_called_once = true;
+	for(size_t i=0; i < count; ++i)
+		is_each_called_once = is_each_called_once && calls[i] == 1;
+	CHECK(is_each_called_once);
+	CHECK(is_worker_valid);
+}
+
+int main()
+{
+	mt19937 random(79);
+	Graph<int, double> graph = make_random_graph<int, double>(500, 1500, 1, 100, true, random);
+	CSRGraph<int, double> snapshot(graph);
+	const size_t thread_counts[] = { 1, 2, 4, 0 };
+	for(size_t i=0; i < sizeof(thread_counts)/sizeof(thread_counts[0]); ++i)
+	{
+		ThreadPool pool(thread_counts[i]);
+		CHECK(pool.get_num_threads() >= 1);
+		check_batch(graph, pool, random);
+		check_batch(snapshot, pool, random);
+		check_parallel_for(pool);
+	}
+	return finish_test();
+}
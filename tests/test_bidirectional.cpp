@@ -0,0 +1,167 @@
+#include <list>
+#include <random>
+#include <set>
+#include "astar.h"
+#include "csrgraph.h"
+#include "landmarks.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<int, int> Search;
+
+//       ,     ,
+//         .
+static void check_random_queries(bool is_asymmetric)
+{
+	mt19937 random(is_asymmetric ? 17 : 5);
+	Search::AStarDefaultHeuristic heuristic;
+	Search::BidirectionalSearchContext context;
+	for(int graph_index=0; graph_index < 40; ++graph_index)
+	{
+		Graph<int, int> graph = make_random_graph<int, int>(60, 120, 1, 20, is_asymmetric, random);
+		for(int query=0; query < 50; ++query)
+		{
+			set<int> start_group = make_random_group(60, 2, random);
+			set<int> goal_group = make_random_group(60, 2, random);
+			int reference_cost;
+			bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+
+			list<int> path;
+			int cost = -1;
+			bool is_found = Search::find_shortest_path_bidirectional(graph, start_group, goal_group, heuristic,
+				context, path, cost);
+			CHECK(is_found == is_reachable);
+			if(is_found && is_reachable)
+			{
+				CHECK(cost == reference_cost);
+				CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+			}
+		}
+	}
+}
+
+//  0 - 1 - 2,    :    2    0->1  1->2.
+static void check_direction_dependent_weights()
+{
+	Graph<int, int> graph(3);
+	graph.add_edge(0, 1, 1);
+	graph.add_edge(1, 2, 1);
+	graph.set_edge_weight(1, 0, 100);
+	graph.set_edge_weight(2, 1, 100);
+	Search::AStarDefaultHeuristic heuristic;
+	list<int> path;
+	int cost = -1;
+	CHECK(Search::find_shortest_path_bidirectional(graph, set<int>{0}, set<int>{2}, heuristic, path, cost));
+	CHECK(cost == 2);
+	CHECK(Search::find_shortest_path_bidirectional(graph, set<int>{2}, set<int>{0}, heuristic, path, cost));
+	CHECK(cost == 200);
+}
+
+//          get_edge_weight    
+// (    ) -   ,    CSRGraph   
+//     ,     -   .
+static void check_reverse_weights()
+{
+	mt19937 random(23);
+	uniform_int_distribution<int> vertices(0, 39);
+	Search::AStarDefaultHeuristic heuristic;
+	Search::BidirectionalSearchContext context;
+	for(int graph_index=0; graph_index < 20; ++graph_index)
+	{
+		Graph<int, int> graph = make_random_graph<int, int>(40, 200, 1, 20, true, random);
+		for(int i=0; i < 100; ++i)
+			graph.remove_edge(vertices(random), vertices(random));
+		CSRGraph<int, int> snapshot(graph), stored_snapshot(graph, true);
+		CHECK(!snapshot.has_symmetric_weights() && snapshot.get_reverse_weights() == nullptr);
+		CHECK(stored_snapshot.get_reverse_weights() != nullptr);
+		for(int v=0; v < graph.get_num_vertices(); ++v)
+		{
+			Graph<int, int>::NeighborRange neighbors;
+			CSRGraph<int, int>::NeighborRange snapshot_neighbors, stored_neighbors;
+			graph.get_neighbor_range(v, neighbors);
+			snapshot.get_neighbor_range(v, snapshot_neighbors);
+			stored_snapshot.get_neighbor_range(v, stored_neighbors);
+			for(size_t i=0; i < neighbors.size(); ++i)
+			{
+				int weight = -1;
+				CHECK(graph.get_edge_weight(neighbors.destination(i), v, weight));
+				CHECK(neighbors.reverse_weight(i) == weight);
+				CHECK(snapshot_neighbors.reverse_weight(i) == weight);
+				CHECK(stored_neighbors.reverse_weight(i) == weight);
+			}
+		}
+
+		for(int query=0; query < 30; ++query)
+		{
+			set<int> start_group = make_random_group(40, 2, random);
+			set<int> goal_group = make_random_group(40, 2, random);
+			int reference_cost;
+			bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+
+			list<int> path;
+			int cost = -1;
+			bool is_found = Search::find_shortest_path_bidirectional(query % 2 == 0 ? snapshot : stored_snapshot,
+				start_group, goal_group, heuristic, context, path, cost);
+			CHECK(is_found == is_reachable);
+			if(is_found && is_reachable)
+			{
+				CHECK(cost == reference_cost);
+				CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+			}
+		}
+	}
+
+	//          .
+	Graph<int, int> symmetric_graph = make_random_graph<int, int>(40, 200, 1, 20, false, random);
+	CSRGraph<int, int> symmetric_snapshot(symmetric_graph, true);
+	CHECK(symmetric_snapshot.has_symmetric_weights() && symmetric_snapshot.get_reverse_weights() == nullptr);
+	CSRGraph<int, int>::NeighborRange symmetric_neighbors;
+	for(int v=0; v < symmetric_graph.get_num_vertices(); ++v)
+	{
+		symmetric_snapshot.get_neighbor_range(v, symmetric_neighbors);
+		for(size_t i=0; i < symmetric_neighbors.size(); ++i)
+			CHECK(symmetric_neighbors.reverse_weight(i) == symmetric_neighbors.weight(i));
+	}
+}
+
+// ALT       :     
+//     ,      ,       .
+static void check_asymmetric_landmarks()
+{
+	mt19937 random(31);
+	Search::BidirectionalSearchContext context;
+	for(int graph_index=0; graph_index < 20; ++graph_index)
+	{
+		Graph<int, int> graph = make_random_graph<int, int>(60, 150, 1, 100, true, random);
+		AStarLandmarkHeuristic<int, int> heuristic(graph, 4);
+		for(int query=0; query < 50; ++query)
+		{
+			set<int> start_group = make_random_group(60, 2, random);
+			set<int> goal_group = make_random_group(60, 2, random);
+			int reference_cost;
+			bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+
+			list<int> path;
+			int cost = -1;
+			bool is_found = Search::find_shortest_path_bidirectional(graph, start_group, goal_group, heuristic,
+				context, path, cost);
+			CHECK(is_found == is_reachable);
+			if(is_found && is_reachable)
+			{
+				CHECK(cost == reference_cost);
+				CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+			}
+		}
+	}
+}
+
+int main()
+{
+	check_direction_dependent_weights();
+	check_reverse_weights();
+	check_random_queries(false);
+	check_random_queries(true);
+	check_asymmetric_landmarks();
+	return finish_test();
+}
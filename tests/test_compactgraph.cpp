@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <list>
+#include <random>
+#include <set>
+#include "astar.h"
+#include "compactgraph.h"
+#include "testing.h"
+
+using namespace std;
+
+//   :     (  )   
+//        ;  A*        ,
+//               .
+template<typename TEdgeWeight, typename TQuantizedWeight>
+static void check_quantization(const Graph<int, TEdgeWeight>& graph, bool is_exact, mt19937& random)
+{
+	typedef AStarSearch<int, TEdgeWeight> Search;
+	bool store_reverse_weights = random() % 2 == 0;
+	CompactGraph<int, TEdgeWeight, TQuantizedWeight> compact(graph, store_reverse_weights);
+	const TEdgeWeight scale = compact.get_scale();
+	CHECK(TEdgeWeight() < scale);
+	CHECK(!is_exact || scale == static_cast<TEdgeWeight>(1));
+
+	typename Graph<int, TEdgeWeight>::NeighborRange neighbors;
+	typename CompactGraph<int, TEdgeWeight, TQuantizedWeight>::NeighborRange compact_neighbors;
+	for(int v=0; v < graph.get_num_vertices(); ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		compact.get_neighbor_range(v, compact_neighbors);
+		CHECK(compact_neighbors.size() == neighbors.size());
+		for(size_t i=0; i < neighbors.size() && i < compact_neighbors.size(); ++i)
+		{
+			CHECK(compact_neighbors.destination(i) == neighbors.destination(i));
+			CHECK(compact_neighbors.weight(i) >= neighbors.weight(i));
+			CHECK(compact_neighbors.weight(i) - neighbors.weight(i) < scale);
+			CHECK(compact_neighbors.reverse_weight(i) >= neighbors.reverse_weight(i));
+			CHECK(compact_neighbors.reverse_weight(i) - neighbors.reverse_weight(i) < scale);
+			CHECK(!is_exact || compact_neighbors.weight(i) == neighbors.weight(i));
+		}
+	}
+
+	typename Search::AStarDefaultHeuristic heuristic;
+	typename Search::SearchContext context;
+	for(int query=0; query < 50; ++query)
+	{
+		set<int> start_group = make_random_group(graph.get_num_vertices(), 2, random);
+		set<int> goal_group = make_random_group(graph.get_num_vertices(), 2, random);
+		list<int> reference_path, path;
+		TEdgeWeight reference_cost = TEdgeWeight(), cost = TEdgeWeight();
+		bool is_reachable = Search::find_shortest_path(graph, start_group, goal_group, heuristic, context,
+			reference_path, reference_cost);
+		bool is_found = Search::find_shortest_path(compact, start_group, goal_group, heuristic, context, path, cost);
+		CHECK(is_found == is_reachable);
+		if(is_found && is_reachable)
+		{
+			CHECK(cost >= reference_cost);
+			CHECK(static_cast<double>(cost) <= static_cast<double>(reference_cost) +
+				static_cast<double>(scale)*static_cast<double>(reference_path.size() - 1));
+			CHECK(is_valid_path(compact, path, start_group, goal_group, cost));
+		}
+	}
+}
+
+//       max_weight,    .
+static Graph<int, double> make_real_graph(int num_vertices, int num_edges, double max_weight, mt19937& random)
+{
+	Graph<int, double> graph = make_random_graph<int, double>(num_vertices, num_edges, 1, 1, false, random);
+	uniform_real_distribution<double> weights(0.0, max_weight);
+	Graph<int, double>::NeighborRange neighbors;
+	for(int v=0; v < num_vertices; ++v)
+	{
+		graph.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			graph.set_edge_weight(v, neighbors.destination(i), weights(random));
+	}
+	return graph;
+}
+
+int main()
+{
+	mt19937 random(47);
+	for(int graph_index=0; graph_index < 10; ++graph_index)
+	{
+		//      std::uint16_t,      .
+		Graph<int, int> graph = make_random_graph<int, int>(100, 300, 1, 3000000, true, random);
+		check_quantization<int, std::uint16_t>(graph, false, random);
+		check_quantization<int, std::uint32_t>(graph, true, random);
+		Graph<int, int> small_graph = make_random_graph<int, int>(100, 300, 1, 65535, true, random);
+		check_quantization<int, std::uint16_t>(small_graph, true, random);
+
+		Graph<int, double> real_graph = make_real_graph(100, 300, graph_index % 2 == 0 ? 1e6 : 0.37, random);
+		check_quantization<double, std::uint16_t>(real_graph, false, random);
+		check_quantization<double, std::uint32_t>(real_graph, false, random);
+	}
+	return finish_test();
+}
@@ -0,0 +1,70 @@
+#include <list>
+#include <random>
+#include <set>
+#include <vector>
+#include "contraction.h"
+#include "testing.h"
+
+using namespace std;
+
+//            ,
+//         .
+static void check_random_graphs(bool is_asymmetric)
+{
+	mt19937 random(is_asymmetric ? 23 : 11);
+	ThreadPool pool(2);
+	for(int graph_index=0; graph_index < 30; ++graph_index)
+	{
+		const int num_vertices = 80;
+		Graph<int, int> graph = make_random_graph<int, int>(num_vertices, 200, 1, 20, is_asymmetric, random);
+		ContractionHierarchy<int, int> hierarchy(graph);
+		ContractionHierarchy<int, int>::QueryContext context;
+
+		for(int query=0; query < 40; ++query)
+		{
+			set<int> start_group = make_random_group(num_vertices, 2, random);
+			set<int> goal_group = make_random_group(num_vertices, 2, random);
+			int reference_cost;
+			bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+
+			list<int> path;
+			int cost = -1;
+			bool is_found = hierarchy.find_shortest_path(start_group, goal_group, context, path, cost);
+			CHECK(is_found == is_reachable);
+			if(is_found && is_reachable)
+			{
+				CHECK(cost == reference_cost);
+				CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+			}
+		}
+
+		vector<int> sources;
+		vector<int> targets;
+		for(int i=0; i < 10; ++i)
+		{
+			sources.push_back(static_cast<int>(random() % num_vertices));
+			targets.push_back(static_cast<int>(random() % num_vertices));
+		}
+		DistanceMatrix<int> matrix;
+		CHECK(hierarchy.find_distance_matrix(sources, targets, pool, matrix));
+		for(size_t i=0; i < sources.size(); ++i)
+		{
+			vector<int> costs = get_reference_costs<Graph<int, int>, int>(graph, set<int>{sources[i]});
+			for(size_t j=0; j < targets.size(); ++j)
+			{
+				int cost = -1;
+				bool is_reachable = costs[targets[j]] != numeric_limits<int>::max();
+				CHECK(matrix.get_cost(static_cast<int>(i), static_cast<int>(j), cost) == is_reachable);
+				if(is_reachable)
+					CHECK(cost == costs[targets[j]]);
+			}
+		}
+	}
+}
+
+int main()
+{
+	check_random_graphs(false);
+	check_random_graphs(true);
+	return finish_test();
+}
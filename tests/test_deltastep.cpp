@@ -0,0 +1,44 @@
+#include <random>
+#include <set>
+#include <vector>
+#include "deltastep.h"
+#include "graph.h"
+#include "testing.h"
+#include "threadpool.h"
+
+using namespace std;
+
+//         delta,     ,
+//  max_weight/delta       size_t.
+template<typename TEdgeWeight>
+static void check_deltas(TEdgeWeight max_weight, const vector<TEdgeWeight>& deltas, unsigned int seed)
+{
+	mt19937 random(seed);
+	ThreadPool pool(4);
+	for(int graph_index=0; graph_index < 5; ++graph_index)
+	{
+		const int num_vertices = 200;
+		Graph<int, TEdgeWeight> graph = make_random_graph<int, TEdgeWeight>(num_vertices, 600,
+			static_cast<TEdgeWeight>(1), max_weight, graph_index % 2 == 1, random);
+		set<int> start_group = make_random_group(num_vertices, 3, random);
+		vector<TEdgeWeight> reference_distances = get_reference_costs<Graph<int, TEdgeWeight>, TEdgeWeight>(graph, start_group);
+		for(size_t i=0; i < deltas.size(); ++i)
+		{
+			vector<TEdgeWeight> distances;
+			vector<int> parents;
+			CHECK((DeltaStepping<int, TEdgeWeight>::find_shortest_path_tree(graph, start_group, deltas[i], pool,
+				distances, parents)));
+			CHECK(distances.size() == reference_distances.size());
+			for(size_t v=0; v < distances.size() && v < reference_distances.size(); ++v)
+				CHECK(distances[v] == reference_distances[v] ||
+					is_close(static_cast<double>(distances[v]), static_cast<double>(reference_distances[v])));
+		}
+	}
+}
+
+int main()
+{
+	check_deltas<int>(5000000, vector<int>{1, 7, 100000}, 5);
+	check_deltas<double>(1e6, vector<double>{1e-300, 1e-9, 0.5, 1e5}, 11);
+	return finish_test();
+}
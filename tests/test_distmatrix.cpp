@@ -0,0 +1,83 @@
+#include <random>
+#include <set>
+#include <vector>
+#include "astar.h"
+#include "csrgraph.h"
+#include "distmatrix.h"
+#include "testing.h"
+#include "threadpool.h"
+
+using namespace std;
+
+typedef AStarSearch<int, int> Search;
+
+//       ;    .
+template<typename TGraph>
+static void check_matrix(const TGraph& graph, const vector<int>& sources, const vector<int>& targets,
+	const DistanceMatrix<int>& matrix)
+{
+	CHECK(matrix.get_num_sources() == static_cast<int>(sources.size()));
+	CHECK(matrix.get_num_targets() == static_cast<int>(targets.size()));
+	for(size_t i=0; i < sources.size(); ++i)
+	{
+		vector<int> reference_costs = get_reference_costs<TGraph, int>(graph, set<int>{sources[i]});
+		for(size_t j=0; j < targets.size(); ++j)
+		{
+			bool is_reachable = reference_costs[targets[j]] != numeric_limits<int>::max();
+			int cost = -1;
+			CHECK(matrix.get_cost(static_cast<int>(i), static_cast<int>(j), cost) == is_reachable);
+			CHECK(matrix.is_found(static_cast<int>(i), static_cast<int>(j)) == is_reachable);
+			if(is_reachable)
+				CHECK(cost == reference_costs[targets[j]]);
+		}
+	}
+}
+
+//    ,    ,     ,   .
+static vector<int> make_random_vertices(int num_vertices, int size, mt19937& random)
+{
+	uniform_int_distribution<int> vertices(0, num_vertices - 1);
+	vector<int> result(size);
+	for(int i=0; i < size; ++i)
+		result[i] = vertices(random);
+	if(size > 1)
+		result[size - 1] = result[0];
+	return result;
+}
+
+int main()
+{
+	mt19937 random(29);
+	ThreadPool pool(4);
+	for(int graph_index=0; graph_index < 10; ++graph_index)
+	{
+		const int num_vertices = 150;
+		//   ,     .
+		Graph<int, int> graph = make_random_graph<int, int>(num_vertices, graph_index < 5 ? 120 : 500, 1, 100,
+			graph_index % 2 == 1, random);
+		CSRGraph<int, int> snapshot(graph);
+		vector<int> sources = make_random_vertices(num_vertices, 12, random);
+		vector<int> targets = make_random_vertices(num_vertices, 20, random);
+		targets[1] = sources[2];
+
+		DistanceMatrix<int> matrix;
+		CHECK(Search::find_distance_matrix(graph, sources, targets, pool, matrix));
+		check_matrix(graph, sources, targets, matrix);
+		CHECK(Search::find_distance_matrix(snapshot, sources, targets, matrix));
+		check_matrix(graph, sources, targets, matrix);
+
+		//    - <<  >>.
+		vector<int> source(1, sources[0]);
+		CHECK(Search::find_distance_matrix(graph, source, targets, pool, matrix));
+		check_matrix(graph, source, targets, matrix);
+	}
+
+	Graph<int, int> graph(5);
+	graph.add_edge(0, 1, 3);
+	DistanceMatrix<int> matrix;
+	CHECK(!Search::find_distance_matrix(graph, vector<int>{0, 5}, vector<int>{1}, pool, matrix));
+	CHECK(!Search::find_distance_matrix(graph, vector<int>{0}, vector<int>{-1}, pool, matrix));
+	CHECK(Search::find_distance_matrix(graph, vector<int>(), vector<int>{1}, pool, matrix));
+	CHECK(matrix.get_num_sources() == 0);
+	return finish_test();
+}
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <list>
+#include <random>
+#include <set>
+#include <vector>
+#include "astar.h"
+#include "goalindex.h"
+#include "graphgen.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<point, double> Search;
+
+// ,     :     
+//    ,   -   .
+class CountingGraph
+{
+	const Graph<point, double>& graph;
+	mutable atomic<size_t> num_value_reads;
+public:
+	typedef Graph<point, double>::NeighborRange NeighborRange;
+
+	explicit CountingGraph(const Graph<point, double>& graph) : graph(graph), num_value_reads(0) { }
+	int get_num_vertices() const { return graph.get_num_vertices(); }
+	bool get_neighbor_range(const int vertex, NeighborRange& neighbors) const { return graph.get_neighbor_range(vertex, neighbors); }
+	bool get_edge_weight(const int origin, const int destination, double& weight) const
+	{
+		return graph.get_edge_weight(origin, destination, weight);
+	}
+	bool get_vertex_value(const int vertex, point& value) const
+	{
+		++num_value_reads;
+		return graph.get_vertex_value(vertex, value);
+	}
+	size_t get_num_value_reads() const { return num_value_reads; }
+	void reset_num_value_reads() { num_value_reads = 0; }
+};
+
+int main()
+{
+	Graph<point, double> graph = GraphGenerator::random_geometric<point, double>(3000, 6, 5);
+	CountingGraph counting_graph(graph);
+	mt19937 random(9);
+	set<int> goal_group;
+	while(goal_group.size() < 300)
+		goal_group.insert(static_cast<int>(random() % 3000));
+	AStarEuclidianGoalSetHeuristic heuristic(graph, goal_group);
+	AStarEuclidianHeuristic plain_heuristic;
+
+	for(int query=0; query < 20; ++query)
+	{
+		set<int> start_group{static_cast<int>(random() % 3000)};
+		list<int> reference_path, path;
+		double reference_cost = -1, cost = -1;
+		bool is_reachable = Search::find_shortest_path(graph, start_group, goal_group, plain_heuristic,
+			reference_path, reference_cost);
+
+		//               .
+		counting_graph.reset_num_value_reads();
+		bool is_found = Search::find_shortest_path(counting_graph, start_group, heuristic.get_goal_group(), heuristic,
+			path, cost);
+		size_t indexed_reads = counting_graph.get_num_value_reads();
+		CHECK(is_found == is_reachable);
+		if(is_found && is_reachable)
+			CHECK(is_close(cost, reference_cost));
+
+		set<int> goal_group_copy(goal_group);
+		counting_graph.reset_num_value_reads();
+		is_found = Search::find_shortest_path(counting_graph, start_group, goal_group_copy, heuristic, path, cost);
+		CHECK(counting_graph.get_num_value_reads() == indexed_reads);
+		CHECK(is_found == is_reachable);
+		if(is_found && is_reachable)
+		{
+			CHECK(is_close(cost, reference_cost));
+			CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+		}
+
+		//      .
+		vector<Search::SearchQuery> queries(4, Search::SearchQuery(start_group, goal_group));
+		vector<Search::SearchResult> results;
+		counting_graph.reset_num_value_reads();
+		Search::find_shortest_paths(counting_graph, queries, heuristic, results);
+		CHECK(counting_graph.get_num_value_reads() == queries.size()*indexed_reads);
+		for(size_t i=0; i < results.size(); ++i)
+			CHECK(results[i].is_found == is_reachable && (!is_reachable || is_close(results[i].shortest_path_cost, reference_cost)));
+	}
+	return finish_test();
+}
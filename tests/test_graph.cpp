@@ -0,0 +1,187 @@
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "testing.h"
+
+using namespace std;
+
+//   :     .      ,
+//  set_edge_weight    ,         .
+class ReferenceGraph
+{
+	int num_vertices;
+	map<pair<int, int>, int> weights;
+	map<int, pair<int, int>> loop_weights;
+public:
+	explicit ReferenceGraph(int num_vertices) : num_vertices(num_vertices) { }
+
+	bool is_valid(int origin, int destination) const
+	{
+		return origin >= 0 && origin < num_vertices && destination >= 0 && destination < num_vertices;
+	}
+	bool contains(int origin, int destination) const
+	{
+		return origin == destination ? loop_weights.count(origin) != 0 : weights.count(make_pair(origin, destination)) != 0;
+	}
+	bool add(int origin, int destination, int weight)
+	{
+		if(!is_valid(origin, destination) || contains(origin, destination))
+			return false;
+		if(origin == destination)
+			loop_weights[origin] = make_pair(weight, weight);
+		else
+		{
+			weights[make_pair(origin, destination)] = weight;
+			weights[make_pair(destination, origin)] = weight;
+		}
+		return true;
+	}
+	bool remove(int origin, int destination)
+	{
+		if(!is_valid(origin, destination) || !contains(origin, destination))
+			return false;
+		if(origin == destination)
+			loop_weights.erase(origin);
+		weights.erase(make_pair(origin, destination));
+		weights.erase(make_pair(destination, origin));
+		return true;
+	}
+	bool set(int origin, int destination, int weight)
+	{
+		if(!is_valid(origin, destination) || !contains(origin, destination))
+			return false;
+		if(origin == destination)
+			loop_weights[origin].first = weight;
+		else
+			weights[make_pair(origin, destination)] = weight;
+		return true;
+	}
+	int get(int origin, int destination) const
+	{
+		return origin == destination ? loop_weights.find(origin)->second.first : weights.find(make_pair(origin, destination))->second;
+	}
+	int get_second_loop_weight(int vertex) const { return loop_weights.find(vertex)->second.second; }
+	size_t get_degree(int vertex) const
+	{
+		size_t degree = loop_weights.count(vertex)*2;
+		for(int v=0; v < num_vertices; ++v)
+			degree += v != vertex && weights.count(make_pair(vertex, v)) != 0 ? 1 : 0;
+		return degree;
+	}
+};
+
+//    :        ,    
+//     (reverse_weight     ,  get_edge_weight,
+//         ).
+static bool is_same_graph(const Graph<int, int>& graph, const ReferenceGraph& reference)
+{
+	const int num_vertices = graph.get_num_vertices();
+	Graph<int, int>::NeighborRange neighbors;
+	for(int v=0; v < num_vertices; ++v)
+	{
+		for(int u=0; u < num_vertices; ++u)
+		{
+			int weight;
+			bool is_found = graph.get_edge_weight(v, u, weight);
+			if(is_found != reference.contains(v, u) || graph.contains_edge(v, u) != is_found)
+				return false;
+			if(is_found && weight != reference.get(v, u))
+				return false;
+		}
+
+		graph.get_neighbor_range(v, neighbors);
+		if(neighbors.size() != reference.get_degree(v))
+			return false;
+		bool is_first_loop_entry = true;
+		for(size_t i=0; i < neighbors.size(); ++i)
+		{
+			int u = neighbors.destination(i);
+			if(!reference.contains(v, u))
+				return false;
+			if(u == v)
+			{
+				int first = reference.get(v, v), second = reference.get_second_loop_weight(v);
+				if(neighbors.weight(i) != (is_first_loop_entry ? first : second) ||
+					neighbors.reverse_weight(i) != first)
+					return false;
+				is_first_loop_entry = false;
+			}
+			else if(neighbors.weight(i) != reference.get(v, u) || neighbors.reverse_weight(i) != reference.get(u, v))
+				return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	//  ,   ,        (16)
+	//     ;  0     .
+	const int num_vertices = 40;
+	mt19937 random(41);
+	uniform_int_distribution<int> vertices(-1, num_vertices);
+	uniform_int_distribution<int> hub_neighbors(0, num_vertices - 1);
+	uniform_int_distribution<int> weights(1, 1000);
+	uniform_int_distribution<int> operations(0, 99);
+
+	for(int round=0; round < 4; ++round)
+	{
+		Graph<int, int> graph(num_vertices);
+		ReferenceGraph reference(num_vertices);
+		for(int step=0; step < 3000; ++step)
+		{
+			int operation = operations(random);
+			//      ,  -  .
+			int add_share = step < 1500 ? 50 : 25;
+			int origin = operation % 5 == 0 ? 0 : vertices(random);
+			int destination = operation % 5 == 0 ? hub_neighbors(random) : vertices(random);
+			if(operation % 7 == 0)
+				destination = origin;
+
+			if(operation < add_share)
+			{
+				int weight = weights(random);
+				CHECK(graph.add_edge(origin, destination, weight) == reference.add(origin, destination, weight));
+			}
+			else if(operation < 70)
+				CHECK(graph.remove_edge(origin, destination) == reference.remove(origin, destination));
+			else if(operation < 90)
+			{
+				int weight = weights(random);
+				CHECK(graph.set_edge_weight(origin, destination, weight) == reference.set(origin, destination, weight));
+			}
+			else if(operation < 95)
+			{
+				//     ,      .
+				vector<EdgeListEntry<int>> edges;
+				for(int i=0; i < 8; ++i)
+					edges.push_back(EdgeListEntry<int>(vertices(random), vertices(random), weights(random)));
+				edges.push_back(edges[0]);
+				edges.push_back(EdgeListEntry<int>(edges[1].destination, edges[1].origin, weights(random)));
+				size_t num_added = 0;
+				for(size_t i=0; i < edges.size(); ++i)
+					num_added += reference.add(edges[i].origin, edges[i].destination, edges[i].weight) ? 1 : 0;
+				CHECK(graph.add_edges(edges) == num_added);
+			}
+			else
+			{
+				//       .
+				vector<EdgeListEntry<int>> edges;
+				for(int i=0; i < 8; ++i)
+					edges.push_back(EdgeListEntry<int>(vertices(random), vertices(random), weights(random)));
+				edges.push_back(EdgeListEntry<int>(edges[0].origin, edges[0].destination, weights(random)));
+				size_t num_updated = 0;
+				for(size_t i=0; i < edges.size(); ++i)
+					num_updated += reference.set(edges[i].origin, edges[i].destination, edges[i].weight) ? 1 : 0;
+				uint64_t version = graph.get_version();
+				CHECK(graph.set_edge_weights(edges) == num_updated);
+				CHECK((graph.get_version() != version) == (num_updated != 0));
+			}
+			CHECK(is_same_graph(graph, reference));
+		}
+	}
+	return finish_test();
+}
@@ -0,0 +1,124 @@
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <random>
+#include <sstream>
+#include <string>
+#include "csrgraph.h"
+#include "graphbinary.h"
+#include "testing.h"
+
+using namespace std;
+
+//     :   , ,       .
+template<typename TGraph>
+static bool is_same_graph(const Graph<point, double>& graph, const TGraph& snapshot)
+{
+	if(snapshot.get_num_vertices() != graph.get_num_vertices())
+		return false;
+	Graph<point, double>::NeighborRange neighbors;
+	typename TGraph::NeighborRange snapshot_neighbors;
+	for(int v=0; v < graph.get_num_vertices(); ++v)
+	{
+		point value, snapshot_value;
+		graph.get_vertex_value(v, value);
+		if(!snapshot.get_vertex_value(v, snapshot_value) || snapshot_value != value)
+			return false;
+		graph.get_neighbor_range(v, neighbors);
+		snapshot.get_neighbor_range(v, snapshot_neighbors);
+		if(snapshot_neighbors.size() != neighbors.size())
+			return false;
+		for(size_t i=0; i < neighbors.size(); ++i)
+			if(snapshot_neighbors.destination(i) != neighbors.destination(i) ||
+				snapshot_neighbors.weight(i) != neighbors.weight(i) ||
+				snapshot_neighbors.reverse_weight(i) != neighbors.reverse_weight(i))
+				return false;
+	}
+	return true;
+}
+
+template<typename TVertexValue, typename TEdgeWeight>
+static bool is_rejected(const string& data)
+{
+	istringstream in_stream(data);
+	try
+	{
+		GraphBinaryIO::from_stream<TVertexValue, TEdgeWeight>(in_stream);
+	}
+	catch(const ios_base::failure&)
+	{
+		return true;
+	}
+	return false;
+}
+
+int main()
+{
+	mt19937 random(17);
+	Graph<point, double> graph = make_random_graph<point, double>(300, 900, 1, 1000, true, random);
+	uniform_real_distribution<double> coordinates(-100.0, 100.0);
+	for(int v=0; v < graph.get_num_vertices(); ++v)
+		graph.set_vertex_value(v, point(coordinates(random), coordinates(random)));
+
+	ostringstream out_stream(ios_base::binary);
+	GraphBinaryIO::save(graph, out_stream);
+	const string data = out_stream.str();
+
+	istringstream in_stream(data, ios_base::binary);
+	CSRGraph<point, double> loaded = GraphBinaryIO::from_stream<point, double>(in_stream);
+	CHECK(is_same_graph(graph, loaded));
+
+	const string file_name = "test_graphbinary.spgb";
+	{
+		ofstream file(file_name.c_str(), ios_base::binary);
+		file.write(data.data(), static_cast<streamsize>(data.size()));
+	}
+	{
+		CSRGraph<point, double> mapped = GraphBinaryIO::map_file<point, double>(file_name);
+		CHECK(is_same_graph(graph, mapped));
+	}
+	remove(file_name.c_str());
+
+	//            .
+	CHECK(loaded.get_reverse_weights() == nullptr && !loaded.has_symmetric_weights());
+	ostringstream stored_stream(ios_base::binary);
+	GraphBinaryIO::save(graph, stored_stream, true);
+	const string stored_data = stored_stream.str();
+	CHECK(stored_data.size() == data.size() + loaded.get_num_edges()*sizeof(double));
+	istringstream stored_in_stream(stored_data, ios_base::binary);
+	CSRGraph<point, double> loaded_stored = GraphBinaryIO::from_stream<point, double>(stored_in_stream);
+	CHECK(loaded_stored.get_reverse_weights() != nullptr);
+	CHECK(is_same_graph(graph, loaded_stored));
+
+	Graph<point, double> symmetric_graph = make_random_graph<point, double>(300, 900, 1, 1000, false, random);
+	ostringstream symmetric_stream(ios_base::binary);
+	GraphBinaryIO::save(symmetric_graph, symmetric_stream, true);
+	istringstream symmetric_in_stream(symmetric_stream.str(), ios_base::binary);
+	CSRGraph<point, double> loaded_symmetric = GraphBinaryIO::from_stream<point, double>(symmetric_in_stream);
+	CHECK(loaded_symmetric.has_symmetric_weights() && loaded_symmetric.get_reverse_weights() == nullptr);
+	CHECK(is_same_graph(symmetric_graph, loaded_symmetric));
+
+	//    .
+	string unknown_flag = data;
+	unknown_flag[28] |= 0x04;
+	CHECK((is_rejected<point, double>(unknown_flag)));
+
+	//  .
+	CHECK((is_rejected<point, double>(data.substr(0, data.size() - 8))));
+	CHECK((is_rejected<point, double>(data.substr(0, 20))));
+
+	//        .
+	uniform_int_distribution<size_t> positions(64, data.size() - 1);
+	for(int i=0; i < 50; ++i)
+	{
+		string corrupted = data;
+		corrupted[positions(random)] ^= 0x10;
+		CHECK((is_rejected<point, double>(corrupted)));
+	}
+
+	// ,    :         .
+	CHECK((is_rejected<point, float>(data)));
+	CHECK((is_rejected<point, long long>(data)));
+	CHECK((is_rejected<int, double>(data)));
+	return finish_test();
+}
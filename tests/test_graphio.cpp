@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <ios>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "graphio.h"
+#include "testing.h"
+#include "threadpool.h"
+
+using namespace std;
+
+//        .
+template<typename TVertexValue, typename TEdgeWeight>
+static bool is_same_graph(const Graph<TVertexValue, TEdgeWeight>& graph, const Graph<TVertexValue, TEdgeWeight>& other)
+{
+	if(graph.get_num_vertices() != other.get_num_vertices())
+		return false;
+	typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors;
+	for(int v=0; v < graph.get_num_vertices(); ++v)
+	{
+		TVertexValue value, other_value;
+		graph.get_vertex_value(v, value);
+		other.get_vertex_value(v, other_value);
+		if(value != other_value)
+			return false;
+		vector<pair<int, TEdgeWeight>> edges, other_edges;
+		graph.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			edges.push_back(make_pair(neighbors.destination(i), neighbors.weight(i)));
+		other.get_neighbor_range(v, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			other_edges.push_back(make_pair(neighbors.destination(i), neighbors.weight(i)));
+		sort(edges.begin(), edges.end());
+		sort(other_edges.begin(), other_edges.end());
+		if(edges != other_edges)
+			return false;
+	}
+	return true;
+}
+
+template<typename TLoader>
+static bool is_rejected(const string& text, const TLoader& loader)
+{
+	istringstream in_stream(text);
+	try
+	{
+		loader(in_stream);
+	}
+	catch(const ios_base::failure&)
+	{
+		return true;
+	}
+	return false;
+}
+
+//   graph.txt:  , ,      \r\n.
+//   -   ,       .
+static string make_int_text(int num_vertices, int num_edges, mt19937& random)
+{
+	uniform_int_distribution<int> vertices(0, num_vertices - 1);
+	uniform_int_distribution<int> weights(1, 1000);
+	ostringstream text;
+	text << num_vertices << "\n";
+	for(int i=0; i < num_edges; ++i)
+	{
+		text << vertices(random) << "\t" << vertices(random) << " " << weights(random) << (i % 7 == 0 ? "\r\n" : "\n");
+		if(i % 1000 == 0)
+			text << "\n";
+	}
+	return text.str();
+}
+
+//   graph2.txt:     .
+static string make_double_text(int num_vertices, int num_edges, mt19937& random)
+{
+	uniform_int_distribution<int> vertices(0, num_vertices - 1);
+	uniform_real_distribution<double> coordinates(-1000.0, 1000.0);
+	vector<int> order(num_vertices);
+	for(int v=0; v < num_vertices; ++v)
+		order[v] = v;
+	shuffle(order.begin(), order.end(), random);
+	ostringstream text;
+	text.precision(17);
+	text << num_vertices << "\n";
+	for(int i=0; i < num_vertices; ++i)
+		text << order[i] << " " << coordinates(random) << " " << coordinates(random) << "\n";
+	for(int i=0; i < num_edges; ++i)
+		text << vertices(random) << " " << vertices(random) << "\n";
+	return text.str();
+}
+
+int main()
+{
+	mt19937 random(23);
+	ThreadPool pool(4);
+
+	string int_text = make_int_text(2000, 30000, random);
+	istringstream int_stream(int_text), bulk_int_stream(int_text);
+	Graph<int, int> int_graph = GraphIO::from_stream_int(int_stream);
+	CHECK(is_same_graph(int_graph, GraphIO::bulk_from_stream_int(bulk_int_stream, pool)));
+
+	string double_text = make_double_text(2000, 20000, random);
+	istringstream double_stream(double_text), bulk_double_stream(double_text);
+	Graph<point, double> double_graph = GraphIO::from_stream_double_double(double_stream);
+	CHECK(is_same_graph(double_graph, GraphIO::bulk_from_stream_double_double(bulk_double_stream, pool)));
+
+	//     ,     .
+	auto load_int = [&pool](istream& in_stream) { GraphIO::bulk_from_stream_int(in_stream, pool); };
+	auto load_double = [&pool](istream& in_stream) { GraphIO::bulk_from_stream_double_double(in_stream, pool); };
+	CHECK(is_rejected(int_text + "1 2\n", load_int));
+	CHECK(is_rejected(int_text + "1 2 3 4\n", load_int));
+	CHECK(is_rejected("3\n0 1 5\n1 x 7\n2 0 1\n", load_int));
+	CHECK(is_rejected("three\n0 1 5\n", load_int));
+	CHECK(is_rejected(double_text + "1\n", load_double));
+	CHECK(is_rejected("2\n0 0.5 1.5\n1 abc 2\n0 1\n", load_double));
+	CHECK(is_rejected("2\n0 0.5 1.5\n", load_double));
+	CHECK(!is_rejected("3\n0 1 5\n\n1 2 7\n", load_int));
+	return finish_test();
+}
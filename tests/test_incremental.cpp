@@ -0,0 +1,82 @@
+#include <list>
+#include <random>
+#include <set>
+#include "graph.h"
+#include "incremental.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef IncrementalSearch<int, int> Search;
+
+static void check_search(Search& search, const Graph<int, int>& graph, const set<int>& start_group, const set<int>& goal_group)
+{
+	int reference_cost;
+	bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+	list<int> path;
+	int cost = -1;
+	bool is_found = search.find_shortest_path(path, cost);
+	CHECK(is_found == is_reachable);
+	if(is_found && is_reachable)
+	{
+		CHECK(cost == reference_cost);
+		CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+	}
+}
+
+//        g:       .
+static void check_zero_weight_cycle()
+{
+	Graph<int, int> graph(6);
+	graph.add_edge(5, 2, 0);
+	graph.add_edge(2, 0, 1);
+	Search search(graph);
+	search.set_start_group(set<int>{5});
+	search.set_goal_group(set<int>{0});
+	check_search(search, graph, set<int>{5}, set<int>{0});
+}
+
+//        ;    
+//        .
+static void check_random_graphs()
+{
+	mt19937 random(15);
+	for(int graph_index=0; graph_index < 30; ++graph_index)
+	{
+		const int num_vertices = 30;
+		Graph<int, int> graph = make_random_graph<int, int>(num_vertices, 70, 0, 4, graph_index % 2 == 1, random);
+		set<int> start_group = make_random_group(num_vertices, 2, random);
+		set<int> goal_group = make_random_group(num_vertices, 2, random);
+		Search search(graph);
+		search.set_start_group(start_group);
+		search.set_goal_group(goal_group);
+		check_search(search, graph, start_group, goal_group);
+
+		uniform_int_distribution<int> vertices(0, num_vertices - 1);
+		uniform_int_distribution<int> weights(0, 4);
+		for(int change=0; change < 20; ++change)
+		{
+			int origin = vertices(random);
+			Graph<int, int>::NeighborRange neighbors;
+			graph.get_neighbor_range(origin, neighbors);
+			if(neighbors.size() == 0)
+				continue;
+			int destination = neighbors.destination(random() % neighbors.size());
+			graph.set_edge_weight(origin, destination, weights(random));
+			search.notify_edge_changed(origin, destination);
+			if(change % 5 == 4)
+			{
+				start_group = make_random_group(num_vertices, 2, random);
+				search.set_start_group(start_group);
+			}
+			check_search(search, graph, start_group, goal_group);
+		}
+	}
+}
+
+int main()
+{
+	check_zero_weight_cycle();
+	check_random_graphs();
+	return finish_test();
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+#include "astar.h"
+#include "isochrone.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<int, int> Search;
+
+//     :    ,    ,
+//     -   (u, w),   cost(u) <=  < cost(u) +  .
+static void check_isochrone(const Graph<int, int>& graph, const set<int>& start_group, const vector<int>& budgets,
+	const Isochrone<int>& isochrone)
+{
+	const int infinity = numeric_limits<int>::max();
+	vector<int> reference_costs = get_reference_costs<Graph<int, int>, int>(graph, start_group);
+
+	vector<int> sorted_budgets(budgets);
+	sort(sorted_budgets.begin(), sorted_budgets.end());
+	sorted_budgets.erase(unique(sorted_budgets.begin(), sorted_budgets.end()), sorted_budgets.end());
+	CHECK(isochrone.get_num_budgets() == static_cast<int>(sorted_budgets.size()));
+	if(isochrone.get_num_budgets() != static_cast<int>(sorted_budgets.size()))
+		return;
+
+	for(int k=0; k < isochrone.get_num_budgets(); ++k)
+	{
+		CHECK(isochrone.get_budget(k) == sorted_budgets[k]);
+		size_t num_vertices = 0, num_frontier_edges = 0;
+		Graph<int, int>::NeighborRange neighbors;
+		for(int v=0; v < graph.get_num_vertices(); ++v)
+		{
+			if(reference_costs[v] == infinity || sorted_budgets[k] < reference_costs[v])
+				continue;
+			++num_vertices;
+			graph.get_neighbor_range(v, neighbors);
+			for(size_t i=0; i < neighbors.size(); ++i)
+				if(sorted_budgets[k] < reference_costs[v] + neighbors.weight(i))
+					++num_frontier_edges;
+		}
+		CHECK(isochrone.get_num_vertices(k) == num_vertices);
+
+		const vector<IsochroneEdge<int>>& frontier = isochrone.get_frontier(k);
+		CHECK(frontier.size() == num_frontier_edges);
+		for(size_t i=0; i < frontier.size(); ++i)
+		{
+			CHECK(reference_costs[frontier[i].origin] != infinity);
+			CHECK(frontier[i].remaining_cost == sorted_budgets[k] - reference_costs[frontier[i].origin]);
+			//    ,      ,  
+			//      ,    get_edge_weight.
+			bool is_edge = false;
+			graph.get_neighbor_range(frontier[i].origin, neighbors);
+			for(size_t j=0; j < neighbors.size(); ++j)
+				is_edge = is_edge || (neighbors.destination(j) == frontier[i].destination &&
+					frontier[i].remaining_cost < neighbors.weight(j));
+			CHECK(is_edge && frontier[i].remaining_cost >= 0);
+		}
+	}
+
+	int last_cost = 0;
+	for(size_t i=0; i < isochrone.get_num_vertices(); ++i)
+	{
+		int vertex = isochrone.get_vertex(i);
+		int parent = isochrone.get_parent(i);
+		CHECK(isochrone.get_cost(i) == reference_costs[vertex]);
+		CHECK(isochrone.get_cost(i) >= last_cost);
+		last_cost = isochrone.get_cost(i);
+		if(parent == -1)
+			CHECK(start_group.count(vertex) == 1);
+		else
+		{
+			int weight = 0;
+			CHECK(graph.get_edge_weight(parent, vertex, weight) && reference_costs[parent] + weight == reference_costs[vertex]);
+		}
+	}
+}
+
+int main()
+{
+	mt19937 random(37);
+	Search::SearchContext context;
+	for(int graph_index=0; graph_index < 10; ++graph_index)
+	{
+		const int num_vertices = 200;
+		Graph<int, int> graph = make_random_graph<int, int>(num_vertices, graph_index < 5 ? 250 : 600, 1, 20,
+			graph_index % 2 == 1, random);
+		for(int query=0; query < 10; ++query)
+		{
+			set<int> start_group = make_random_group(num_vertices, 3, random);
+			//     ;       ,
+			//    ,        .
+			vector<int> budgets{30, 5, 0, 30, 12, 5, 60, -3};
+			Isochrone<int> isochrone;
+			CHECK(Search::find_reachable(graph, start_group, budgets, context, isochrone));
+			check_isochrone(graph, start_group, budgets, isochrone);
+		}
+	}
+
+	Graph<int, int> graph(3);
+	Isochrone<int> isochrone;
+	CHECK(!Search::find_reachable(graph, set<int>{3}, vector<int>{10}, isochrone));
+	CHECK(Search::find_reachable(graph, set<int>{0}, vector<int>(), isochrone));
+	CHECK(isochrone.get_num_budgets() == 0 && isochrone.get_num_vertices() == 0);
+	return finish_test();
+}
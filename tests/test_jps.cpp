@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <ios>
+#include <list>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include "astar.h"
+#include "graphio.h"
+#include "gridgraph.h"
+#include "jps.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<point, double> Search;
+
+static GridGraph make_random_grid(int width, int height, double density, mt19937& random)
+{
+	GridGraph grid(width, height);
+	bernoulli_distribution is_blocked(density);
+	for(int y=0; y < height; ++y)
+		for(int x=0; x < width; ++x)
+			if(is_blocked(random))
+				grid.set_blocked(x, y, true);
+	return grid;
+}
+
+//    1..max_size  ; ,     .
+static set<int> make_free_group(const GridGraph& grid, int max_size, mt19937& random)
+{
+	uniform_int_distribution<int> xs(0, grid.get_width() - 1), ys(0, grid.get_height() - 1), sizes(1, max_size);
+	set<int> group;
+	int size = sizes(random);
+	for(int attempt=0; attempt < 1000 && static_cast<int>(group.size()) < size; ++attempt)
+	{
+		int x = xs(random), y = ys(random);
+		if(grid.is_free(x, y))
+			group.insert(grid.get_vertex(x, y));
+	}
+	return group;
+}
+
+//    ,    ,         .
+static void check_blocked_bits(const GridGraph& grid, mt19937& random)
+{
+	uniform_int_distribution<int> xs(-70, grid.get_width() + 5), ys(-70, grid.get_height() + 5);
+	for(int i=0; i < 500; ++i)
+	{
+		int x = xs(random), y = ys(random);
+		uint64_t row = grid.get_blocked_row(x, y), column = grid.get_blocked_column(x, y);
+		bool is_row_correct = true, is_column_correct = true;
+		for(int bit=0; bit < 64; ++bit)
+		{
+			is_row_correct = is_row_correct && (((row >> bit) & 1) != 0) == !grid.is_free(x + bit, y);
+			is_column_correct = is_column_correct && (((column >> bit) & 1) != 0) == !grid.is_free(x, y + bit);
+		}
+		CHECK(is_row_correct);
+		CHECK(is_column_correct);
+	}
+}
+
+// JPS     ,   A*    GridGraph,         .
+static void check_random_grids(int width, int height, double density, unsigned int seed)
+{
+	mt19937 random(seed);
+	AStarOctileHeuristic heuristic;
+	Search::SearchContext astar_context;
+	JumpPointSearch::SearchContext context;
+	for(int grid_index=0; grid_index < 5; ++grid_index)
+	{
+		GridGraph grid = make_random_grid(width, height, density, random);
+		check_blocked_bits(grid, random);
+		for(int query=0; query < 40; ++query)
+		{
+			set<int> start_group = make_free_group(grid, query % 4 == 0 ? 3 : 1, random);
+			set<int> goal_group = make_free_group(grid, query % 4 == 1 ? 3 : 1, random);
+			if(start_group.empty() || goal_group.empty())
+				continue;
+
+			list<int> reference_path;
+			double reference_cost = -1;
+			bool is_reachable = Search::find_shortest_path(grid, start_group, goal_group, heuristic, astar_context,
+				reference_path, reference_cost);
+
+			list<int> path;
+			double cost = -1;
+			bool is_found = JumpPointSearch::find_shortest_path(grid, start_group, goal_group, heuristic, context,
+				path, cost);
+			CHECK(is_found == is_reachable);
+			if(is_found && is_reachable)
+			{
+				CHECK(is_close(cost, reference_cost));
+				CHECK(is_valid_path(grid, path, start_group, goal_group, cost));
+			}
+		}
+	}
+}
+
+static bool is_map_rejected(const string& data)
+{
+	istringstream in_stream(data);
+	try
+	{
+		GraphIO::grid_from_stream(in_stream);
+	}
+	catch(const ios_base::failure&)
+	{
+		return true;
+	}
+	return false;
+}
+
+//  Moving AI    ; '.', 'G'  'S' -  .
+static void check_grid_from_stream()
+{
+	istringstream in_stream("type octile\nheight 3\nwidth 4\nmap\n.@G.\nS.T.\n..WO\n");
+	GridGraph grid = GraphIO::grid_from_stream(in_stream);
+	CHECK(grid.get_width() == 4 && grid.get_height() == 3);
+	const char* rows[3] = { ".@G.", "S.T.", "..WO" };
+	for(int y=0; y < 3; ++y)
+		for(int x=0; x < 4; ++x)
+			CHECK(grid.is_free(x, y) == (rows[y][x] == '.' || rows[y][x] == 'G' || rows[y][x] == 'S'));
+
+	CHECK(is_map_rejected("type octile\nheight 2\nwidth 3\nmap\n...\n..\n"));
+	CHECK(is_map_rejected("type octile\nheight 2\nwidth 3\nmap\n...\n"));
+	CHECK(is_map_rejected("type octile\nheight 0\nwidth 3\nmap\n"));
+	CHECK(is_map_rejected("type octile\ndepth 2\nwidth 3\nmap\n...\n...\n"));
+	CHECK(is_map_rejected("octile\nheight 1\nwidth 1\nmap\n.\n"));
+}
+
+int main()
+{
+	//    64,        .
+	check_random_grids(37, 23, 0.25, 3);
+	check_random_grids(70, 65, 0.3, 5);
+	check_random_grids(129, 40, 0.1, 7);
+	//  :     64-  .
+	check_random_grids(200, 150, 0.02, 11);
+	check_random_grids(1, 90, 0.05, 13);
+	check_grid_from_stream();
+	return finish_test();
+}
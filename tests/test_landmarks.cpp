@@ -0,0 +1,116 @@
+#include <cstring>
+#include <ios>
+#include <list>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "astar.h"
+#include "landmarks.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<int, int> Search;
+typedef AStarLandmarkHeuristic<int, int> LandmarkHeuristic;
+
+//      ,  A*   -   ,
+//         .
+static void check_random_graphs(bool is_asymmetric)
+{
+	mt19937 random(is_asymmetric ? 31 : 7);
+	for(int graph_index=0; graph_index < 20; ++graph_index)
+	{
+		const int num_vertices = 60;
+		Graph<int, int> graph = make_random_graph<int, int>(num_vertices, 150, 1, 30, is_asymmetric, random);
+		LandmarkHeuristic heuristic(graph, 4, graph_index % 2 == 0 ? LandmarkHeuristic::AVOID : LandmarkHeuristic::FARTHEST);
+
+		for(int goal=0; goal < num_vertices; ++goal)
+		{
+			vector<int> costs_to_goal(num_vertices);
+			for(int v=0; v < num_vertices; ++v)
+				get_reference_cost(graph, set<int>{v}, set<int>{goal}, costs_to_goal[v]);
+			for(int v=0; v < num_vertices; ++v)
+			{
+				if(costs_to_goal[v] != numeric_limits<int>::max())
+					CHECK(heuristic.get_lower_bound(v, goal) <= costs_to_goal[v]);
+				Graph<int, int>::NeighborRange neighbors;
+				graph.get_neighbor_range(v, neighbors);
+				for(size_t i=0; i < neighbors.size(); ++i)
+					CHECK(heuristic.get_lower_bound(v, goal) <=
+						neighbors.weight(i) + heuristic.get_lower_bound(neighbors.destination(i), goal));
+			}
+		}
+
+		Search::SearchContext context;
+		for(int query=0; query < 50; ++query)
+		{
+			set<int> start_group = make_random_group(num_vertices, 2, random);
+			set<int> goal_group = make_random_group(num_vertices, 2, random);
+			int reference_cost;
+			bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+			list<int> path;
+			int cost = -1;
+			bool is_found = Search::find_shortest_path(graph, start_group, goal_group, heuristic, context, path, cost);
+			CHECK(is_found == is_reachable);
+			if(is_found && is_reachable)
+			{
+				CHECK(cost == reference_cost);
+				CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+			}
+		}
+	}
+}
+
+static bool is_load_rejected(const Graph<int, int>& graph, const string& data)
+{
+	LandmarkHeuristic heuristic;
+	istringstream in_stream(data);
+	try
+	{
+		heuristic.load(graph, in_stream);
+	}
+	catch(const ios_base::failure&)
+	{
+		return true;
+	}
+	return false;
+}
+
+//      ;          .
+static void check_save_load()
+{
+	mt19937 random(3);
+	Graph<int, int> graph = make_random_graph<int, int>(40, 100, 1, 30, true, random);
+	LandmarkHeuristic heuristic(graph, 3);
+	ostringstream out_stream;
+	heuristic.save(out_stream);
+	string data = out_stream.str();
+
+	LandmarkHeuristic loaded;
+	istringstream in_stream(data);
+	loaded.load(graph, in_stream);
+	CHECK(loaded.get_landmarks() == heuristic.get_landmarks());
+	for(int v=0; v < 40; ++v)
+		for(int goal=0; goal < 40; ++goal)
+			CHECK(loaded.get_lower_bound(v, goal) == heuristic.get_lower_bound(v, goal));
+
+	Graph<int, int> other_graph(41);
+	CHECK(is_load_rejected(other_graph, data));
+
+	//            .
+	string bad_landmark = data;
+	int landmark = 40;
+	memcpy(&bad_landmark[4 + 3*sizeof(int)], &landmark, sizeof(int));
+	CHECK(is_load_rejected(graph, bad_landmark));
+	CHECK(is_load_rejected(graph, data.substr(0, data.size() - 1)));
+}
+
+int main()
+{
+	check_random_graphs(false);
+	check_random_graphs(true);
+	check_save_load();
+	return finish_test();
+}
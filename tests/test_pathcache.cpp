@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <list>
+#include <random>
+#include <set>
+#include <vector>
+#include "astar.h"
+#include "pathcache.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<int, int> Search;
+typedef ShortestPathCache<int, int> PathCache;
+
+//      ,       .
+static void check_query(const Graph<int, int>& graph, PathCache& cache, const set<int>& start_group,
+	const set<int>& goal_group, Search::SearchContext& context)
+{
+	Search::AStarDefaultHeuristic heuristic;
+	int reference_cost;
+	bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+	list<int> path;
+	int cost = -1;
+	bool is_found = cache.find_shortest_path(start_group, goal_group, heuristic, context, path, cost);
+	CHECK(is_found == is_reachable);
+	if(is_found && is_reachable)
+	{
+		CHECK(cost == reference_cost);
+		CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+	}
+}
+
+//   :  ,     .
+static void change_graph(Graph<int, int>& graph, mt19937& random)
+{
+	uniform_int_distribution<int> vertices(0, graph.get_num_vertices() - 1);
+	uniform_int_distribution<int> weights(1, 30);
+	uniform_int_distribution<int> operations(0, 2);
+	for(bool is_changed=false; !is_changed; )
+	{
+		int origin = vertices(random), destination = vertices(random);
+		switch(operations(random))
+		{
+		case 0:
+			is_changed = graph.set_edge_weight(origin, destination, weights(random));
+			break;
+		case 1:
+			is_changed = graph.add_edge(origin, destination, weights(random));
+			break;
+		default:
+			is_changed = graph.remove_edge(origin, destination);
+			break;
+		}
+	}
+}
+
+//      :      
+//   ,   tree_threshold        .
+static void check_repeated_queries(size_t tree_threshold, unsigned int seed)
+{
+	mt19937 random(seed);
+	const int num_vertices = 80;
+	Graph<int, int> graph = make_random_graph<int, int>(num_vertices, 200, 1, 30, true, random);
+	PathCache cache(graph, 1 << 24, tree_threshold);
+	Search::SearchContext context;
+
+	vector<set<int>> start_groups, goal_groups;
+	for(int i=0; i < 4; ++i)
+	{
+		start_groups.push_back(make_random_group(num_vertices, 2, random));
+		goal_groups.push_back(make_random_group(num_vertices, 2, random));
+	}
+	uniform_int_distribution<int> group_indices(0, 3);
+	for(int query=0; query < 2000; ++query)
+	{
+		bool is_changed = query % 100 == 99;
+		if(is_changed)
+			change_graph(graph, random);
+		check_query(graph, cache, start_groups[group_indices(random)], goal_groups[group_indices(random)], context);
+		//     ,      .
+		if(is_changed)
+			CHECK(cache.get_num_entries() == 1);
+	}
+	CHECK(cache.get_num_hits() > 0);
+	CHECK(cache.get_num_misses() > 0);
+	CHECK((cache.get_num_tree_hits() > 0) == (tree_threshold != 0));
+	CHECK(cache.get_memory_usage() <= static_cast<size_t>(1 << 24));
+}
+
+//      ,    .
+static void check_memory_limit(unsigned int seed)
+{
+	mt19937 random(seed);
+	const int num_vertices = 80;
+	Graph<int, int> graph = make_random_graph<int, int>(num_vertices, 200, 1, 30, true, random);
+	//      (80   8 )   .
+	const size_t max_memory = 3000;
+	PathCache cache(graph, max_memory, 2);
+	Search::SearchContext context;
+	size_t max_entries = 0;
+	for(int query=0; query < 1000; ++query)
+	{
+		if(query % 200 == 199)
+			change_graph(graph, random);
+		check_query(graph, cache, make_random_group(num_vertices, 1, random), make_random_group(num_vertices, 2, random),
+			context);
+		CHECK(cache.get_memory_usage() <= max_memory);
+		max_entries = max(max_entries, cache.get_num_entries());
+	}
+	CHECK(max_entries > 1 && max_entries < 30);
+	CHECK(cache.get_num_tree_hits() > 0);
+
+	// ,     ,  .
+	PathCache small_cache(graph, 1000, 1);
+	for(int query=0; query < 20; ++query)
+	{
+		check_query(graph, small_cache, set<int>{0}, make_random_group(num_vertices, 2, random), context);
+		CHECK(small_cache.get_memory_usage() <= 1000);
+	}
+	CHECK(small_cache.get_num_tree_hits() == 0);
+}
+
+int main()
+{
+	check_repeated_queries(0, 53);
+	check_repeated_queries(3, 59);
+	check_memory_limit(61);
+	return finish_test();
+}
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "pqueue.h"
+#include "testing.h"
+
+using namespace std;
+
+//  : std::priority_queue   .     ,
+//    (         )    .
+template<typename TPriority>
+class ReferenceQueue
+{
+	typedef pair<TPriority, int> Entry;
+	priority_queue<Entry, vector<Entry>, greater<Entry>> entries;
+	vector<TPriority> priorities;
+	vector<bool> is_queued;
+	size_t num_queued;
+public:
+	explicit ReferenceQueue(size_t num_keys) : priorities(num_keys), is_queued(num_keys, false), num_queued(0) { }
+	bool contains(int key) const { return is_queued[key]; }
+	size_t size() const { return num_queued; }
+	TPriority get_priority(int key) const { return priorities[key]; }
+	void set(int key, const TPriority& priority)
+	{
+		if(!is_queued[key])
+			++num_queued;
+		is_queued[key] = true;
+		priorities[key] = priority;
+		entries.push(Entry(priority, key));
+	}
+	void remove(int key)
+	{
+		is_queued[key] = false;
+		--num_queued;
+	}
+	TPriority top_priority()
+	{
+		while(!is_queued[entries.top().second] || priorities[entries.top().second] != entries.top().first)
+			entries.pop();
+		return entries.top().first;
+	}
+};
+
+//     :   ,    -   
+//     (      ).   .
+template<typename TQueue, typename TPriority>
+static TPriority check_pop(TQueue& queue, ReferenceQueue<TPriority>& reference)
+{
+	int key = queue.top();
+	TPriority priority = queue.top_priority();
+	CHECK(priority == reference.top_priority());
+	CHECK(reference.contains(key) && reference.get_priority(key) == priority);
+	queue.pop();
+	reference.remove(key);
+	CHECK(!queue.contains(key));
+	return priority;
+}
+
+//   push, pop, decrease_key, update_key  remove    ;
+//       .
+template<typename TPriority, int Arity>
+static void check_indexed_queue(unsigned int seed)
+{
+	mt19937 random(seed);
+	const int num_keys = 200;
+	uniform_int_distribution<int> keys(0, num_keys - 1), priorities(0, 50), operations(0, 99);
+	IndexedPriorityQueue<TPriority, Arity> queue(num_keys);
+	ReferenceQueue<TPriority> reference(num_keys);
+	for(int step=0; step < 20000; ++step)
+	{
+		int key = keys(random), operation = operations(random);
+		TPriority priority = static_cast<TPriority>(priorities(random));
+		if(!queue.contains(key))
+		{
+			CHECK(!reference.contains(key));
+			if(operation < 60)
+			{
+				queue.push(key, priority);
+				reference.set(key, priority);
+			}
+		}
+		else if(operation < 30)
+		{
+			TPriority current = queue.get_priority(key);
+			CHECK(current == reference.get_priority(key));
+			if(priority < current)
+			{
+				queue.decrease_key(key, priority);
+				reference.set(key, priority);
+			}
+			else
+			{
+				bool is_rejected = false;
+				try
+				{
+					queue.decrease_key(key, current + 1);
+				}
+				catch(const invalid_argument&)
+				{
+					is_rejected = true;
+				}
+				CHECK(is_rejected);
+			}
+		}
+		else if(operation < 55)
+		{
+			queue.update_key(key, priority);
+			reference.set(key, priority);
+		}
+		else if(operation < 70)
+		{
+			queue.remove(key);
+			reference.remove(key);
+		}
+		if(operation >= 70 && !queue.empty())
+			check_pop(queue, reference);
+		CHECK(queue.size() == reference.size());
+	}
+
+	//      .
+	TPriority last = TPriority();
+	for(bool is_first=true; !queue.empty(); is_first=false)
+	{
+		TPriority priority = check_pop(queue, reference);
+		CHECK(is_first || !(priority < last));
+		last = priority;
+	}
+	CHECK(reference.size() == 0);
+}
+
+//    RadixHeap:      .
+//       (    ),   
+//  ,      ,    .  clear() 
+//     .
+template<typename TPriority>
+static void check_radix_heap(long long min_priority, long long max_priority, unsigned int seed)
+{
+	mt19937 random(seed);
+	const int num_keys = 200;
+	uniform_int_distribution<int> keys(0, num_keys - 1), operations(0, 99);
+	uniform_int_distribution<long long> small_steps(0, 20);
+	RadixHeap<TPriority> queue(num_keys);
+	for(int round=0; round < 4; ++round)
+	{
+		ReferenceQueue<TPriority> reference(num_keys);
+		long long last = min_priority;
+		for(int step=0; step < 5000; ++step)
+		{
+			int key = keys(random), operation = operations(random);
+			long long priority = operation % 4 == 0 ?
+				uniform_int_distribution<long long>(last, max_priority)(random) :
+				(last > max_priority - 20 ? max_priority : last + small_steps(random));
+			if(!queue.contains(key))
+			{
+				if(operation < 60)
+				{
+					queue.push(key, static_cast<TPriority>(priority));
+					reference.set(key, static_cast<TPriority>(priority));
+				}
+			}
+			else if(operation < 35)
+			{
+				long long current = static_cast<long long>(queue.get_priority(key));
+				CHECK(current == static_cast<long long>(reference.get_priority(key)));
+				long long decreased = uniform_int_distribution<long long>(last, current)(random);
+				queue.decrease_key(key, static_cast<TPriority>(decreased));
+				reference.set(key, static_cast<TPriority>(decreased));
+			}
+			if(operation >= 60 && !queue.empty())
+				last = static_cast<long long>(check_pop(queue, reference));
+			CHECK(queue.size() == reference.size());
+		}
+		for(int i=0; i < 20 && !queue.empty(); ++i)
+			last = static_cast<long long>(check_pop(queue, reference));
+		queue.clear();
+		CHECK(queue.empty() && queue.size() == 0);
+	}
+}
+
+int main()
+{
+	check_indexed_queue<int, 2>(1);
+	check_indexed_queue<int, 4>(2);
+	check_indexed_queue<double, 8>(3);
+	check_indexed_queue<long long, 3>(4);
+	check_radix_heap<int>(-1000000, 1000000, 5);
+	check_radix_heap<int>(numeric_limits<int>::min(), numeric_limits<int>::max(), 6);
+	check_radix_heap<long long>(numeric_limits<long long>::min(), numeric_limits<long long>::max(), 7);
+	check_radix_heap<short>(numeric_limits<short>::min(), numeric_limits<short>::max(), 8);
+	check_radix_heap<unsigned int>(0, numeric_limits<unsigned int>::max(), 9);
+	return finish_test();
+}
@@ -0,0 +1,114 @@
+#include <list>
+#include <random>
+#include <set>
+#include <vector>
+#include "astar.h"
+#include "graphio.h"
+#include "reorder.h"
+#include "testing.h"
+
+using namespace std;
+
+//                  .
+template<typename TVertexValue, typename TEdgeWeight>
+static bool is_same_graph(const Graph<TVertexValue, TEdgeWeight>& graph, const Graph<TVertexValue, TEdgeWeight>& reordered,
+	const VertexPermutation& permutation)
+{
+	const int num_vertices = graph.get_num_vertices();
+	if(reordered.get_num_vertices() != num_vertices || permutation.get_num_vertices() != num_vertices)
+		return false;
+	typename Graph<TVertexValue, TEdgeWeight>::NeighborRange neighbors, reordered_neighbors;
+	for(int a=0; a < num_vertices; ++a)
+	{
+		int internal_a = permutation.get_internal_id(a);
+		if(internal_a < 0 || permutation.get_external_id(internal_a) != a)
+			return false;
+		TVertexValue value, reordered_value;
+		graph.get_vertex_value(a, value);
+		reordered.get_vertex_value(internal_a, reordered_value);
+		if(value != reordered_value)
+			return false;
+		graph.get_neighbor_range(a, neighbors);
+		reordered.get_neighbor_range(internal_a, reordered_neighbors);
+		if(reordered_neighbors.size() != neighbors.size())
+			return false;
+		for(int b=0; b < num_vertices; ++b)
+		{
+			TEdgeWeight weight = TEdgeWeight(), reordered_weight = TEdgeWeight();
+			bool is_edge = graph.get_edge_weight(a, b, weight);
+			if(reordered.get_edge_weight(internal_a, permutation.get_internal_id(b), reordered_weight) != is_edge)
+				return false;
+			if(is_edge && reordered_weight != weight)
+				return false;
+		}
+	}
+	return true;
+}
+
+//     ( -  to_internal,  -  to_external)
+//     ,    ,        .
+template<typename TVertexValue, typename TEdgeWeight>
+static void check_queries(const Graph<TVertexValue, TEdgeWeight>& graph, const Graph<TVertexValue, TEdgeWeight>& reordered,
+	const VertexPermutation& permutation, mt19937& random)
+{
+	typedef AStarSearch<TVertexValue, TEdgeWeight> Search;
+	typename Search::AStarDefaultHeuristic heuristic;
+	typename Search::SearchContext context;
+	for(int query=0; query < 50; ++query)
+	{
+		set<int> start_group = make_random_group(graph.get_num_vertices(), 2, random);
+		set<int> goal_group = make_random_group(graph.get_num_vertices(), 2, random);
+		TEdgeWeight reference_cost;
+		bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+
+		set<int> internal_start_group, internal_goal_group;
+		CHECK(permutation.to_internal(start_group, internal_start_group));
+		CHECK(permutation.to_internal(goal_group, internal_goal_group));
+		list<int> path;
+		TEdgeWeight cost = TEdgeWeight();
+		bool is_found = Search::find_shortest_path(reordered, internal_start_group, internal_goal_group, heuristic,
+			context, path, cost);
+		CHECK(is_found == is_reachable);
+		if(is_found && is_reachable)
+		{
+			permutation.to_external(path);
+			CHECK(is_close(static_cast<double>(cost), static_cast<double>(reference_cost)));
+			CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+		}
+	}
+}
+
+int main()
+{
+	mt19937 random(43);
+	for(int graph_index=0; graph_index < 10; ++graph_index)
+	{
+		//  :      .
+		Graph<int, int> graph = make_random_graph<int, int>(120, 300, 1, 50, true, random);
+		for(int v=0; v < graph.get_num_vertices(); ++v)
+			graph.set_vertex_value(v, v*7);
+		VertexPermutation permutation = GraphReordering::compute(graph);
+		Graph<int, int> reordered = permutation.apply(graph);
+		CHECK(is_same_graph(graph, reordered, permutation));
+		check_queries(graph, reordered, permutation, random);
+
+		//       .
+		Graph<point, double> geometric_graph = make_random_graph<point, double>(120, 300, 1, 50, true, random);
+		uniform_real_distribution<double> coordinates(0.0, 1000.0);
+		for(int v=0; v < geometric_graph.get_num_vertices(); ++v)
+			geometric_graph.set_vertex_value(v, point(coordinates(random), coordinates(random)));
+		VertexPermutation geometric_permutation = GraphReordering::compute(geometric_graph);
+		Graph<point, double> geometric_reordered = geometric_permutation.apply(geometric_graph);
+		CHECK(is_same_graph(geometric_graph, geometric_reordered, geometric_permutation));
+		check_queries(geometric_graph, geometric_reordered, geometric_permutation, random);
+	}
+
+	VertexPermutation permutation(vector<int>{2, 0, 1});
+	set<int> internal_group;
+	CHECK(!permutation.to_internal(set<int>{1, 3}, internal_group));
+	CHECK(permutation.get_internal_id(-1) == -1 && permutation.get_external_id(3) == -1);
+	list<int> path{0, 1, 2};
+	permutation.to_external(path);
+	CHECK((path == list<int>{2, 0, 1}));
+	return finish_test();
+}
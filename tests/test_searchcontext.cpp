@@ -0,0 +1,70 @@
+#include <list>
+#include <random>
+#include <set>
+#include "astar.h"
+#include "testing.h"
+
+using namespace std;
+
+//  SearchContext      : ,    .
+//       ,      ,     ,
+//   max_settled (     ),   
+// WEIGHTED  FOCAL,      .
+template<typename TEdgeWeight>
+static void check_context_reuse(unsigned int seed)
+{
+	typedef AStarSearch<int, TEdgeWeight> Search;
+	mt19937 random(seed);
+	typename Search::AStarDefaultHeuristic heuristic;
+	typename Search::SearchContext context;
+	typename Search::BidirectionalSearchContext bidirectional_context;
+	const int sizes[] = { 300, 20, 150, 3, 300, 2, 60 };
+	uniform_int_distribution<int> modes(0, 2), limits(0, 3);
+	for(int round=0; round < 3; ++round)
+		for(size_t size_index=0; size_index < sizeof(sizes)/sizeof(sizes[0]); ++size_index)
+		{
+			const int num_vertices = sizes[size_index];
+			Graph<int, TEdgeWeight> graph = make_random_graph<int, TEdgeWeight>(num_vertices, num_vertices*3, 1, 40,
+				true, random);
+			for(int query=0; query < 20; ++query)
+			{
+				set<int> start_group = make_random_group(num_vertices, 2, random);
+				set<int> goal_group = make_random_group(num_vertices, 2, random);
+				typename Search::SearchOptions options;
+				options.mode = static_cast<typename Search::SearchOptions::Mode>(modes(random));
+				options.suboptimality = 0.5;
+				options.max_settled = limits(random) == 0 ? static_cast<size_t>(num_vertices/4 + 1) : 0;
+
+				list<int> path, fresh_path;
+				TEdgeWeight cost = TEdgeWeight(), fresh_cost = TEdgeWeight();
+				typename Search::SearchContext fresh_context;
+				typename Search::SearchStatus status = Search::find_path(graph, start_group, goal_group, heuristic,
+					options, context, path, cost);
+				typename Search::SearchStatus fresh_status = Search::find_path(graph, start_group, goal_group, heuristic,
+					options, fresh_context, fresh_path, fresh_cost);
+				CHECK(status == fresh_status);
+				CHECK(path == fresh_path);
+				CHECK(status == Search::PATH_NOT_FOUND || cost == fresh_cost);
+				CHECK(context.get_num_settled() == fresh_context.get_num_settled());
+
+				TEdgeWeight reference_cost;
+				bool is_reachable = get_reference_cost(graph, start_group, goal_group, reference_cost);
+				bool is_found = Search::find_shortest_path_bidirectional(graph, start_group, goal_group, heuristic,
+					bidirectional_context, path, cost);
+				CHECK(is_found == is_reachable);
+				if(is_found && is_reachable)
+				{
+					CHECK(is_close(static_cast<double>(cost), static_cast<double>(reference_cost)));
+					CHECK(is_valid_path(graph, path, start_group, goal_group, cost));
+				}
+			}
+		}
+}
+
+int main()
+{
+	//   -  RadixHeap,  - IndexedPriorityQueue.
+	check_context_reuse<int>(71);
+	check_context_reuse<double>(73);
+	return finish_test();
+}
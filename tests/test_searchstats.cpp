@@ -0,0 +1,96 @@
+#include <list>
+#include <random>
+#include <set>
+#include "astar.h"
+#include "landmarks.h"
+#include "searchstats.h"
+#include "testing.h"
+
+using namespace std;
+
+typedef AStarSearch<int, int> Search;
+
+//    A*      :    
+//    ,    ,   ,     
+// .        ,   -   .
+//        .
+template<typename THeuristic>
+static void check_search(const Graph<int, int>& graph, const THeuristic& heuristic, bool is_zero_heuristic,
+	mt19937& random)
+{
+	Search::SearchContext context;
+	SearchStatistics total;
+	size_t total_settled = 0;
+	for(int query=0; query < 100; ++query)
+	{
+		set<int> start_group = make_random_group(graph.get_num_vertices(), 2, random);
+		set<int> goal_group = make_random_group(graph.get_num_vertices(), 2, random);
+		SearchStatistics statistics;
+		list<int> path, reference_path;
+		int cost = -1, reference_cost = -1;
+		bool is_found = Search::find_shortest_path(graph, start_group, goal_group, heuristic, context, statistics,
+			path, cost);
+		CHECK(statistics.num_pops == context.get_num_settled());
+		bool is_reference_found = Search::find_shortest_path(graph, start_group, goal_group, heuristic, context,
+			reference_path, reference_cost);
+		CHECK(is_found == is_reference_found);
+		CHECK(path == reference_path && (!is_found || cost == reference_cost));
+
+		CHECK(statistics.num_pops == (is_found ? statistics.num_settled + 1 : statistics.num_settled));
+		CHECK(is_found || statistics.num_pops == statistics.num_pushes);
+		CHECK(statistics.num_pushes == statistics.num_discovered);
+		CHECK(statistics.num_pops <= statistics.num_pushes);
+		CHECK(statistics.num_decrease_keys <= statistics.num_edges_relaxed);
+		CHECK(statistics.num_heuristic_evaluations == (is_zero_heuristic ? 0 : statistics.num_discovered));
+		CHECK(statistics.heuristic_seconds >= 0.0 && statistics.expansion_seconds >= 0.0);
+
+		//  clear()    .
+		Search::find_shortest_path(graph, start_group, goal_group, heuristic, context, total, path, cost);
+		total_settled += statistics.num_settled;
+		CHECK(total.num_settled == total_settled);
+	}
+	total.clear();
+	CHECK(total.num_settled == 0 && total.num_pops == 0 && total.num_pushes == 0 && total.num_edges_relaxed == 0);
+	CHECK(total.heuristic_seconds == 0.0 && total.expansion_seconds == 0.0);
+}
+
+//      ;     .
+// ,    ,   :     .
+template<typename THeuristic>
+static void check_bidirectional_search(const Graph<int, int>& graph, const THeuristic& heuristic, bool is_zero_heuristic,
+	mt19937& random)
+{
+	Search::BidirectionalSearchContext context;
+	for(int query=0; query < 100; ++query)
+	{
+		set<int> start_group = make_random_group(graph.get_num_vertices(), 2, random);
+		set<int> goal_group = make_random_group(graph.get_num_vertices(), 2, random);
+		SearchStatistics statistics;
+		list<int> path;
+		int cost = -1;
+		Search::find_shortest_path_bidirectional(graph, start_group, goal_group, heuristic, context, statistics,
+			path, cost);
+		CHECK(statistics.num_pops == statistics.num_settled);
+		CHECK(statistics.num_settled == context.get_num_settled());
+		CHECK(statistics.num_pushes == statistics.num_discovered);
+		CHECK(statistics.num_decrease_keys <= statistics.num_edges_relaxed);
+		CHECK(is_zero_heuristic ? statistics.num_heuristic_evaluations == 0 :
+			statistics.num_heuristic_evaluations > 0 && statistics.num_heuristic_evaluations <= statistics.num_discovered);
+	}
+}
+
+int main()
+{
+	mt19937 random(83);
+	for(int graph_index=0; graph_index < 5; ++graph_index)
+	{
+		Graph<int, int> graph = make_random_graph<int, int>(150, 400, 1, 50, graph_index % 2 == 0, random);
+		Search::AStarDefaultHeuristic default_heuristic;
+		AStarLandmarkHeuristic<int, int> landmark_heuristic(graph, 4);
+		check_search(graph, default_heuristic, true, random);
+		check_search(graph, landmark_heuristic, false, random);
+		check_bidirectional_search(graph, default_heuristic, true, random);
+		check_bidirectional_search(graph, landmark_heuristic, false, random);
+	}
+	return finish_test();
+}
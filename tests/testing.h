@@ -0,0 +1,145 @@
+#pragma once
+#ifndef TESTING_H
+#define TESTING_H
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <queue>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+//    .
+//    assert, CHECK    Release-    :  
+//    ,  finish_test   ,       .
+inline int& get_num_failed_checks()
+{
+	static int num_failed_checks = 0;
+	return num_failed_checks;
+}
+
+#define CHECK(condition) \
+	do \
+	{ \
+		if(!(condition)) \
+		{ \
+			++get_num_failed_checks(); \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl; \
+		} \
+	} while(false)
+
+inline int finish_test()
+{
+	if(get_num_failed_checks() != 0)
+	{
+		std::cerr << get_num_failed_checks() << " checks failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+//      [min_weight, max_weight].  is_asymmetric,   
+//     (set_edge_weight    ).
+template<typename TVertexValue, typename TEdgeWeight>
+Graph<TVertexValue, TEdgeWeight> make_random_graph(int num_vertices, int num_edges,
+	TEdgeWeight min_weight, TEdgeWeight max_weight, bool is_asymmetric, std::mt19937& random)
+{
+	Graph<TVertexValue, TEdgeWeight> graph(num_vertices);
+	std::uniform_int_distribution<int> vertices(0, num_vertices - 1);
+	std::uniform_int_distribution<long long> weights(static_cast<long long>(min_weight), static_cast<long long>(max_weight));
+	for(int i=0; i < num_edges; ++i)
+	{
+		int origin = vertices(random);
+		int destination = vertices(random);
+		if(!graph.add_edge(origin, destination, static_cast<TEdgeWeight>(weights(random))))
+			continue;
+		if(is_asymmetric)
+			graph.set_edge_weight(destination, origin, static_cast<TEdgeWeight>(weights(random)));
+	}
+	return graph;
+}
+
+//     :         .
+//    std::numeric_limits<TEdgeWeight>::max().
+template<typename TGraph, typename TEdgeWeight>
+std::vector<TEdgeWeight> get_reference_costs(const TGraph& graph, const std::set<int>& start_group)
+{
+	typedef std::pair<TEdgeWeight, int> QueueEntry;
+	const TEdgeWeight infinity = std::numeric_limits<TEdgeWeight>::max();
+	std::vector<TEdgeWeight> costs(graph.get_num_vertices(), infinity);
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+	for(std::set<int>::const_iterator i=start_group.begin(); i != start_group.end(); ++i)
+	{
+		costs[*i] = TEdgeWeight();
+		queue.push(QueueEntry(TEdgeWeight(), *i));
+	}
+	while(!queue.empty())
+	{
+		QueueEntry top = queue.top();
+		queue.pop();
+		if(costs[top.second] < top.first)
+			continue;
+		typename TGraph::NeighborRange neighbors;
+		graph.get_neighbor_range(top.second, neighbors);
+		for(size_t i=0; i < neighbors.size(); ++i)
+			if(top.first + neighbors.weight(i) < costs[neighbors.destination(i)])
+			{
+				costs[neighbors.destination(i)] = top.first + neighbors.weight(i);
+				queue.push(QueueEntry(costs[neighbors.destination(i)], neighbors.destination(i)));
+			}
+	}
+	return costs;
+}
+
+//      ; false,    .
+template<typename TGraph, typename TEdgeWeight>
+bool get_reference_cost(const TGraph& graph, const std::set<int>& start_group, const std::set<int>& goal_group,
+	TEdgeWeight& cost)
+{
+	std::vector<TEdgeWeight> costs = get_reference_costs<TGraph, TEdgeWeight>(graph, start_group);
+	cost = std::numeric_limits<TEdgeWeight>::max();
+	for(std::set<int>::const_iterator i=goal_group.begin(); i != goal_group.end(); ++i)
+		cost = costs[*i] < cost ? costs[*i] : cost;
+	return cost != std::numeric_limits<TEdgeWeight>::max();
+}
+
+inline bool is_close(double a, double b)
+{
+	return std::fabs(a - b) <= 1e-9*std::max(1.0, std::fabs(b));
+}
+
+//     ,   ,        cost.
+template<typename TGraph, typename TEdgeWeight>
+bool is_valid_path(const TGraph& graph, const std::list<int>& path,
+	const std::set<int>& start_group, const std::set<int>& goal_group, const TEdgeWeight& cost)
+{
+	if(path.empty() || start_group.count(path.front()) == 0 || goal_group.count(path.back()) == 0)
+		return false;
+	TEdgeWeight path_cost = TEdgeWeight();
+	for(std::list<int>::const_iterator i=path.begin(), j=std::next(path.begin()); j != path.end(); ++i, ++j)
+	{
+		TEdgeWeight weight;
+		if(!graph.get_edge_weight(*i, *j, weight))
+			return false;
+		path_cost += weight;
+	}
+	return is_close(static_cast<double>(path_cost), static_cast<double>(cost));
+}
+
+//    1..max_size .
+inline std::set<int> make_random_group(int num_vertices, int max_size, std::mt19937& random)
+{
+	std::uniform_int_distribution<int> vertices(0, num_vertices - 1);
+	std::uniform_int_distribution<int> sizes(1, max_size);
+	std::set<int> group;
+	for(int size=sizes(random); static_cast<int>(group.size()) < size; )
+		group.insert(vertices(random));
+	return group;
+}
+#endif